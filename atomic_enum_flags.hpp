@@ -0,0 +1,184 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <atomic>
+#include "enum_flags.hpp"
+
+namespace kt {
+///
+/// \brief Lock-free atomic wrapper around enum_flags storage
+/// Masks are built through enum_flags::make, so inputs match the non-atomic type: set(Enum...), set(enum_flags), any(Enum...)
+/// Pass an explicit memory order through the enum_flags overloads: set(flags_t::make(...), order)
+/// Modifiers return the value held before the operation
+///
+template <typename Enum, typename Ty = std::uint32_t, typename Tr = enum_trait_linear>
+class atomic_enum_flags {
+	static_assert(std::is_integral_v<Ty>, "Ty must be integral");
+
+	// inputs for flags_t::make: a trailing std::memory_order selects the flags_t overloads instead
+	template <typename... T>
+	using enable_inputs_t = std::enable_if_t<(sizeof...(T) > 0) && (!std::is_same_v<T, std::memory_order> && ...)>;
+
+  public:
+	using type = Enum;
+	using storage_t = Ty;
+	using flags_t = enum_flags<Enum, Ty, Tr>;
+
+	///
+	/// \brief Default constructor (no flags set)
+	///
+	constexpr atomic_enum_flags() noexcept : m_bits(Ty{}) {}
+	///
+	/// \brief Initialize with flags
+	///
+	constexpr atomic_enum_flags(flags_t flags) noexcept : m_bits(static_cast<Ty>(flags)) {}
+
+	atomic_enum_flags(atomic_enum_flags const&) = delete;
+	atomic_enum_flags& operator=(atomic_enum_flags const&) = delete;
+
+	///
+	/// \brief Obtain current flags
+	///
+	flags_t load(std::memory_order order = std::memory_order_seq_cst) const noexcept;
+	///
+	/// \brief Replace current flags
+	///
+	void store(flags_t flags, std::memory_order order = std::memory_order_seq_cst) noexcept;
+	///
+	/// \brief Replace current flags
+	///
+	flags_t exchange(flags_t flags, std::memory_order order = std::memory_order_seq_cst) noexcept;
+
+	///
+	/// \brief Set inputs (fetch_or)
+	///
+	flags_t set(flags_t mask, std::memory_order order = std::memory_order_seq_cst) noexcept;
+	///
+	/// \brief Set inputs (fetch_or, seq_cst)
+	///
+	template <typename... T, typename = enable_inputs_t<T...>>
+	flags_t set(T... t) noexcept {
+		return set(flags_t::make(t...));
+	}
+	///
+	/// \brief Remove inputs (fetch_and)
+	///
+	flags_t reset(flags_t mask, std::memory_order order = std::memory_order_seq_cst) noexcept;
+	///
+	/// \brief Remove inputs (fetch_and, seq_cst)
+	///
+	template <typename... T, typename = enable_inputs_t<T...>>
+	flags_t reset(T... t) noexcept {
+		return reset(flags_t::make(t...));
+	}
+	///
+	/// \brief Toggle inputs (fetch_xor)
+	///
+	flags_t flip(flags_t mask, std::memory_order order = std::memory_order_seq_cst) noexcept;
+	///
+	/// \brief Toggle inputs (fetch_xor, seq_cst)
+	///
+	template <typename... T, typename = enable_inputs_t<T...>>
+	flags_t flip(T... t) noexcept {
+		return flip(flags_t::make(t...));
+	}
+	///
+	/// \brief Add set bits and remove unset bits in one atomic step (CAS loop)
+	///
+	flags_t update(flags_t set, flags_t reset = {}, std::memory_order order = std::memory_order_seq_cst) noexcept;
+	///
+	/// \brief Apply a chain of set / reset / flip steps in one atomic step (CAS loop)
+	///
+	template <typename... S>
+	flags_t apply(flag_ops<S...> const& ops, std::memory_order order = std::memory_order_seq_cst) noexcept;
+
+	///
+	/// \brief Test for flag
+	///
+	bool test(Enum flag, std::memory_order order = std::memory_order_seq_cst) const noexcept { return load(order).test(flag); }
+	///
+	/// \brief Test if any bits are set
+	///
+	bool any(std::memory_order order = std::memory_order_seq_cst) const noexcept { return load(order).any(); }
+	///
+	/// \brief Test if any bits in mask are set
+	///
+	bool any(flags_t mask, std::memory_order order = std::memory_order_seq_cst) const noexcept { return load(order).any(mask); }
+	///
+	/// \brief Test if any inputs are set (seq_cst)
+	///
+	template <typename... T, typename = enable_inputs_t<T...>>
+	bool any(T... t) const noexcept {
+		return any(flags_t::make(t...));
+	}
+	///
+	/// \brief Test if all bits in mask are set
+	///
+	bool all(flags_t mask, std::memory_order order = std::memory_order_seq_cst) const noexcept { return load(order).all(mask); }
+	///
+	/// \brief Test if all inputs are set (seq_cst)
+	///
+	template <typename... T, typename = enable_inputs_t<T...>>
+	bool all(T... t) const noexcept {
+		return all(flags_t::make(t...));
+	}
+
+	///
+	/// \brief Test if operations on Ty are always lock-free
+	///
+	static constexpr bool is_always_lock_free = std::atomic<Ty>::is_always_lock_free;
+
+  private:
+	std::atomic<Ty> m_bits;
+};
+
+// impl
+
+template <typename Enum, typename Ty, typename Tr>
+typename atomic_enum_flags<Enum, Ty, Tr>::flags_t atomic_enum_flags<Enum, Ty, Tr>::load(std::memory_order order) const noexcept {
+	return flags_t::from_value(m_bits.load(order));
+}
+template <typename Enum, typename Ty, typename Tr>
+void atomic_enum_flags<Enum, Ty, Tr>::store(flags_t flags, std::memory_order order) noexcept {
+	m_bits.store(static_cast<Ty>(flags), order);
+}
+template <typename Enum, typename Ty, typename Tr>
+typename atomic_enum_flags<Enum, Ty, Tr>::flags_t atomic_enum_flags<Enum, Ty, Tr>::exchange(flags_t flags, std::memory_order order) noexcept {
+	return flags_t::from_value(m_bits.exchange(static_cast<Ty>(flags), order));
+}
+template <typename Enum, typename Ty, typename Tr>
+typename atomic_enum_flags<Enum, Ty, Tr>::flags_t atomic_enum_flags<Enum, Ty, Tr>::set(flags_t mask, std::memory_order order) noexcept {
+	return flags_t::from_value(m_bits.fetch_or(static_cast<Ty>(mask), order));
+}
+template <typename Enum, typename Ty, typename Tr>
+typename atomic_enum_flags<Enum, Ty, Tr>::flags_t atomic_enum_flags<Enum, Ty, Tr>::reset(flags_t mask, std::memory_order order) noexcept {
+	return flags_t::from_value(m_bits.fetch_and(static_cast<Ty>(~static_cast<Ty>(mask)), order));
+}
+template <typename Enum, typename Ty, typename Tr>
+typename atomic_enum_flags<Enum, Ty, Tr>::flags_t atomic_enum_flags<Enum, Ty, Tr>::flip(flags_t mask, std::memory_order order) noexcept {
+	return flags_t::from_value(m_bits.fetch_xor(static_cast<Ty>(mask), order));
+}
+template <typename Enum, typename Ty, typename Tr>
+typename atomic_enum_flags<Enum, Ty, Tr>::flags_t atomic_enum_flags<Enum, Ty, Tr>::update(flags_t set, flags_t reset, std::memory_order order) noexcept {
+	Ty expected = m_bits.load(std::memory_order_relaxed);
+	Ty desired{};
+	do {
+		desired = static_cast<Ty>((expected | static_cast<Ty>(set)) & ~static_cast<Ty>(reset));
+	} while (!m_bits.compare_exchange_weak(expected, desired, order, std::memory_order_relaxed));
+	return flags_t::from_value(expected);
+}
+template <typename Enum, typename Ty, typename Tr>
+template <typename... S>
+typename atomic_enum_flags<Enum, Ty, Tr>::flags_t atomic_enum_flags<Enum, Ty, Tr>::apply(flag_ops<S...> const& ops, std::memory_order order) noexcept {
+	auto const affine = ops.template resolve<flags_t>();
+	auto const keep = static_cast<Ty>(affine.keep);
+	auto const toggle = static_cast<Ty>(affine.toggle);
+	Ty expected = m_bits.load(std::memory_order_relaxed);
+	Ty desired{};
+	do {
+		desired = static_cast<Ty>((expected & keep) ^ toggle);
+	} while (!m_bits.compare_exchange_weak(expected, desired, order, std::memory_order_relaxed));
+	return flags_t::from_value(expected);
+}
+} // namespace kt
@@ -0,0 +1,44 @@
+#include "bench_common.hpp"
+#include "flag_batch.hpp"
+
+// configure with -DKT_FLAGS_OPENMP_SIMD=ON to compare the omp simd kernels
+namespace kt::bench {
+namespace {
+template <typename EF>
+void batch_set(benchmark::State& state) {
+	auto data = sample<EF>();
+	auto const mask = EF::make(inputs<EF>::a);
+	for (auto _ : state) {
+		kt::batch_set(data.data(), data.size(), mask);
+		benchmark::DoNotOptimize(data.data());
+		benchmark::ClobberMemory();
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void batch_count_all(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	auto const mask = EF::make(inputs<EF>::a, inputs<EF>::b);
+	for (auto _ : state) { benchmark::DoNotOptimize(kt::batch_count_all(data.data(), data.size(), mask)); }
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void reduce_or(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	for (auto _ : state) { benchmark::DoNotOptimize(kt::reduce_or(data.data(), data.size())); }
+	set_items(state, data.size());
+}
+} // namespace
+
+#define KT_BENCH_BATCH(op)                                                                                                                             \
+	BENCHMARK_TEMPLATE(op, linear_flags<std::uint8_t>);                                                                                                \
+	BENCHMARK_TEMPLATE(op, linear_flags<std::uint16_t>);                                                                                               \
+	BENCHMARK_TEMPLATE(op, linear_flags<std::uint32_t>);                                                                                               \
+	BENCHMARK_TEMPLATE(op, linear_flags<std::uint64_t>)
+
+KT_BENCH_BATCH(batch_set);
+KT_BENCH_BATCH(batch_count_all);
+KT_BENCH_BATCH(reduce_or);
+} // namespace kt::bench
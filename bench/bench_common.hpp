@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "enum_flags.hpp"
+#include "uint_flags.hpp"
+
+namespace kt::bench {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+enum class pot_e : std::uint32_t { a = 1 << 0, b = 1 << 1, c = 1 << 2, d = 1 << 3, e = 1 << 4, f = 1 << 5, g = 1 << 6, h = 1 << 7, eCOUNT_ = 1 << 8 };
+
+template <typename Ty>
+using linear_flags = enum_flags<linear_e, Ty>;
+template <typename Ty>
+using pot_flags = enum_flags<pot_e, Ty, enum_trait_pot>;
+
+inline constexpr std::size_t sample_size_v = 1024;
+
+///
+/// \brief Inputs used by the benchmarks for flags type EF
+///
+template <typename EF>
+struct inputs {
+	static constexpr auto a = EF::type::b;
+	static constexpr auto b = EF::type::f;
+};
+template <typename Ty>
+struct inputs<uint_flags<Ty>> {
+	static constexpr Ty a = Ty{1} << 1;
+	static constexpr Ty b = Ty{1} << 5;
+};
+
+///
+/// \brief Fixed pseudo-random sample of raw values (any bit of Ty may be set)
+///
+template <typename EF>
+std::vector<EF> const& sample() {
+	static std::vector<EF> const ret = [] {
+		using Ty = typename EF::value_type;
+		std::mt19937_64 rng(42);
+		std::vector<EF> ret;
+		ret.reserve(sample_size_v);
+		for (std::size_t i = 0; i < sample_size_v; ++i) { ret.push_back(EF::from_value(static_cast<Ty>(rng()))); }
+		return ret;
+	}();
+	return ret;
+}
+
+inline void set_items(benchmark::State& state, std::size_t per_iteration) {
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(per_iteration));
+}
+} // namespace kt::bench
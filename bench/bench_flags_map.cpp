@@ -0,0 +1,76 @@
+#include <unordered_map>
+#include "bench_common.hpp"
+#include "flags_hash.hpp"
+
+namespace kt::bench {
+namespace {
+using key_t = linear_flags<std::uint64_t>;
+
+// low-entropy keys (few bits set), as permission masks are
+std::vector<key_t> make_keys(std::size_t count, std::uint64_t seed) {
+	std::mt19937_64 rng(seed);
+	std::vector<key_t> ret;
+	ret.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) { ret.push_back(key_t::from_value(rng() & rng() & rng())); }
+	return ret;
+}
+
+template <typename Map>
+Map make_map(std::vector<key_t> const& keys) {
+	Map ret;
+	for (std::size_t i = 0; i < keys.size(); ++i) { ret[keys[i]] = i; }
+	return ret;
+}
+
+template <typename Map>
+std::size_t const* lookup(Map const& map, key_t key) {
+	if constexpr (std::is_same_v<Map, flags_map<key_t, std::size_t>>) {
+		return map.find(key);
+	} else {
+		auto const it = map.find(key);
+		return it == map.end() ? nullptr : &it->second;
+	}
+}
+
+template <typename Map>
+void map_find_hit(benchmark::State& state) {
+	auto const keys = make_keys(static_cast<std::size_t>(state.range(0)), 1);
+	auto const map = make_map<Map>(keys);
+	for (auto _ : state) {
+		for (auto const& key : keys) { benchmark::DoNotOptimize(lookup(map, key)); }
+	}
+	set_items(state, keys.size());
+}
+
+template <typename Map>
+void map_find_miss(benchmark::State& state) {
+	auto const keys = make_keys(static_cast<std::size_t>(state.range(0)), 1);
+	auto const misses = make_keys(keys.size(), 2);
+	auto const map = make_map<Map>(keys);
+	for (auto _ : state) {
+		for (auto const& key : misses) { benchmark::DoNotOptimize(lookup(map, key)); }
+	}
+	set_items(state, misses.size());
+}
+
+template <typename Map>
+void map_insert(benchmark::State& state) {
+	auto const keys = make_keys(static_cast<std::size_t>(state.range(0)), 1);
+	for (auto _ : state) {
+		auto map = make_map<Map>(keys);
+		benchmark::DoNotOptimize(map);
+	}
+	set_items(state, keys.size());
+}
+
+using kt_map_t = flags_map<key_t, std::size_t>;
+using std_map_t = std::unordered_map<key_t, std::size_t>;
+} // namespace
+
+BENCHMARK_TEMPLATE(map_find_hit, kt_map_t)->Arg(64)->Arg(4096)->Arg(262144);
+BENCHMARK_TEMPLATE(map_find_hit, std_map_t)->Arg(64)->Arg(4096)->Arg(262144);
+BENCHMARK_TEMPLATE(map_find_miss, kt_map_t)->Arg(64)->Arg(4096)->Arg(262144);
+BENCHMARK_TEMPLATE(map_find_miss, std_map_t)->Arg(64)->Arg(4096)->Arg(262144);
+BENCHMARK_TEMPLATE(map_insert, kt_map_t)->Arg(64)->Arg(4096)->Arg(262144);
+BENCHMARK_TEMPLATE(map_insert, std_map_t)->Arg(64)->Arg(4096)->Arg(262144);
+} // namespace kt::bench
@@ -0,0 +1,77 @@
+#include <array>
+#include "bench_common.hpp"
+#include "bit_utils.hpp"
+#include "enum_reflect.hpp"
+
+namespace kt::bench {
+namespace {
+enum class offset_e { a = 8, b, c, d, e, f, g, h, eCOUNT_ };
+enum class gap_e { a = 0, b = 1, c = 4, d = 5, e = 9, f = 12, g = 13, h = 20, eCOUNT_ };
+
+// contiguous range from Begin: enum_trait_lut computes the shift, no table
+using offset_flags = enum_flags<offset_e, std::uint32_t, enum_trait_lut<offset_e::a>>;
+// gaps: enum_trait_reflect compacts the enumerators through a table indexed by underlying value
+using gap_flags = enum_flags<gap_e, std::uint32_t, enum_trait_reflect>;
+
+template <typename Enum>
+std::vector<Enum> const& enumerators() {
+	static std::vector<Enum> const ret = [] {
+		auto const values = enum_reflect<Enum>::values_v;
+		std::mt19937_64 rng(42);
+		std::vector<Enum> ret;
+		ret.reserve(sample_size_v);
+		for (std::size_t i = 0; i < sample_size_v; ++i) { ret.push_back(values[rng() % values.size()]); }
+		return ret;
+	}();
+	return ret;
+}
+
+// gapped alternatives to the table: rank by popcount of the enumerators below e, and a linear search of values_v
+constexpr std::uint32_t gap_present_v = [] {
+	std::uint32_t ret{};
+	for (auto const e : enum_reflect<gap_e>::values_v) { ret |= std::uint32_t{1} << static_cast<int>(e); }
+	return ret;
+}();
+
+std::uint32_t mask_rank(gap_e e) {
+	auto const below = gap_present_v & ((std::uint32_t{1} << static_cast<int>(e)) - 1);
+	return std::uint32_t{1} << detail::popcount(below);
+}
+
+std::uint32_t mask_search(gap_e e) {
+	constexpr auto values = enum_reflect<gap_e>::values_v;
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		if (values[i] == e) { return std::uint32_t{1} << i; }
+	}
+	return 0;
+}
+
+template <typename EF>
+void mask(benchmark::State& state) {
+	auto const& data = enumerators<typename EF::type>();
+	for (auto _ : state) {
+		EF ret{};
+		for (auto const e : data) { ret |= EF(e); }
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+
+template <std::uint32_t (*Mask)(gap_e)>
+void gap_mask(benchmark::State& state) {
+	auto const& data = enumerators<gap_e>();
+	for (auto _ : state) {
+		std::uint32_t ret{};
+		for (auto const e : data) { ret |= Mask(e); }
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(mask, linear_flags<std::uint32_t>);
+BENCHMARK_TEMPLATE(mask, offset_flags);
+BENCHMARK_TEMPLATE(mask, gap_flags);
+BENCHMARK_TEMPLATE(gap_mask, mask_rank);
+BENCHMARK_TEMPLATE(gap_mask, mask_search);
+} // namespace kt::bench
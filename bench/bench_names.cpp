@@ -0,0 +1,109 @@
+#include <array>
+#include <string>
+#include <string_view>
+#include "bench_common.hpp"
+#include "flag_names.hpp"
+
+namespace kt::bench {
+namespace {
+constexpr flag_names<8> names_v({"alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel"});
+std::array<std::string, 8> const naive_names_v = {"alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel"};
+
+using flags_t = linear_flags<std::uint8_t>;
+
+// naive: enumerate every enumerator, test, concatenate std::strings
+std::string format_naive(flags_t flags) {
+	std::string ret;
+	for (auto const e : enumerate_enum<linear_e>{}) {
+		if (!flags.test(e)) { continue; }
+		if (!ret.empty()) { ret += '|'; }
+		ret += naive_names_v[static_cast<std::size_t>(e)];
+	}
+	return ret;
+}
+
+// naive: split into std::strings, compare against every name
+bool parse_naive(std::string const& str, flags_t& out) {
+	flags_t ret{};
+	std::size_t start = 0;
+	while (start <= str.size()) {
+		auto end = str.find('|', start);
+		if (end == std::string::npos) { end = str.size(); }
+		std::string const token = str.substr(start, end - start);
+		bool found = false;
+		for (std::size_t i = 0; i < naive_names_v.size(); ++i) {
+			if (naive_names_v[i] == token) {
+				ret.set(static_cast<linear_e>(i));
+				found = true;
+				break;
+			}
+		}
+		if (!found) { return false; }
+		start = end + 1;
+	}
+	out = ret;
+	return true;
+}
+
+std::vector<std::string> const& formatted() {
+	static std::vector<std::string> const ret = [] {
+		std::vector<std::string> ret;
+		for (auto const& f : sample<flags_t>()) {
+			// parsers need at least one name
+			ret.push_back(format_naive(f.any() ? f : flags_t(linear_e::a)));
+		}
+		return ret;
+	}();
+	return ret;
+}
+
+void format_to_chars(benchmark::State& state) {
+	auto const& data = sample<flags_t>();
+	char buf[128];
+	for (auto _ : state) {
+		for (auto const& f : data) {
+			benchmark::DoNotOptimize(format_flags(f, names_v, buf, sizeof(buf)));
+			benchmark::ClobberMemory();
+		}
+	}
+	set_items(state, data.size());
+}
+
+void format_string(benchmark::State& state) {
+	auto const& data = sample<flags_t>();
+	for (auto _ : state) {
+		for (auto const& f : data) { benchmark::DoNotOptimize(format_naive(f)); }
+	}
+	set_items(state, data.size());
+}
+
+void parse_from_chars(benchmark::State& state) {
+	auto const& data = formatted();
+	for (auto _ : state) {
+		for (auto const& str : data) {
+			flags_t out{};
+			benchmark::DoNotOptimize(from_chars(str.data(), str.data() + str.size(), out, names_v));
+			benchmark::DoNotOptimize(out);
+		}
+	}
+	set_items(state, data.size());
+}
+
+void parse_string(benchmark::State& state) {
+	auto const& data = formatted();
+	for (auto _ : state) {
+		for (auto const& str : data) {
+			flags_t out{};
+			benchmark::DoNotOptimize(parse_naive(str, out));
+			benchmark::DoNotOptimize(out);
+		}
+	}
+	set_items(state, data.size());
+}
+} // namespace
+
+BENCHMARK(format_to_chars);
+BENCHMARK(format_string);
+BENCHMARK(parse_from_chars);
+BENCHMARK(parse_string);
+} // namespace kt::bench
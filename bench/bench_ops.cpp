@@ -0,0 +1,129 @@
+#include "bench_common.hpp"
+
+namespace kt::bench {
+namespace {
+template <typename EF>
+void make(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	for (auto _ : state) {
+		for (auto const& f : data) {
+			auto ret = EF::make(inputs<EF>::a, inputs<EF>::b);
+			ret |= f;
+			benchmark::DoNotOptimize(ret);
+		}
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void update(benchmark::State& state) {
+	auto data = sample<EF>();
+	auto const set = EF::make(inputs<EF>::a);
+	auto const reset = EF::make(inputs<EF>::b);
+	for (auto _ : state) {
+		for (auto& f : data) { f.update(set, reset); }
+		benchmark::DoNotOptimize(data.data());
+		benchmark::ClobberMemory();
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void count(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) { ret += f.count(); }
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void any(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	auto const mask = EF::make(inputs<EF>::a, inputs<EF>::b);
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) { ret += f.any(mask) ? 1 : 0; }
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void all(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	auto const mask = EF::make(inputs<EF>::a, inputs<EF>::b);
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) { ret += f.all(mask) ? 1 : 0; }
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void test(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) { ret += f[inputs<EF>::b] ? 1 : 0; }
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void set_bits(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) {
+			for (auto const bit : f.set_bits()) { benchmark::DoNotOptimize(bit); }
+			++ret;
+		}
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void enumerate(benchmark::State& state) {
+	using Enum = typename EF::type;
+	using range_t = std::conditional_t<EF::is_linear_v, enumerate_enum<Enum>, enumerate_enum<Enum, Enum::a, Enum::eCOUNT_, enum_trait_pot>>;
+	auto const& data = sample<EF>();
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) {
+			for (auto const e : range_t{}) { ret += f.test(e) ? 1 : 0; }
+		}
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+} // namespace
+
+#define KT_BENCH_WIDTHS(op, flags)                                                                                                                     \
+	BENCHMARK_TEMPLATE(op, flags<std::uint8_t>);                                                                                                       \
+	BENCHMARK_TEMPLATE(op, flags<std::uint16_t>);                                                                                                      \
+	BENCHMARK_TEMPLATE(op, flags<std::uint32_t>);                                                                                                      \
+	BENCHMARK_TEMPLATE(op, flags<std::uint64_t>)
+
+#define KT_BENCH_ENUMS(op)                                                                                                                             \
+	KT_BENCH_WIDTHS(op, linear_flags);                                                                                                                 \
+	KT_BENCH_WIDTHS(op, pot_flags)
+
+#define KT_BENCH_ALL(op)                                                                                                                               \
+	KT_BENCH_ENUMS(op);                                                                                                                                \
+	KT_BENCH_WIDTHS(op, uint_flags)
+
+KT_BENCH_ALL(make);
+KT_BENCH_ALL(update);
+KT_BENCH_ALL(count);
+KT_BENCH_ALL(any);
+KT_BENCH_ALL(all);
+KT_BENCH_ALL(test);
+KT_BENCH_ALL(set_bits);
+KT_BENCH_ENUMS(enumerate);
+} // namespace kt::bench
@@ -0,0 +1,83 @@
+#include "bench_common.hpp"
+
+namespace kt::bench {
+namespace {
+// baseline count(): one test and branch per bit of storage
+template <typename Ty>
+std::size_t count_per_bit(Ty bits) {
+	std::size_t ret{};
+	for (std::size_t i = 0; i < sizeof(Ty) * 8; ++i) {
+		if ((bits & static_cast<Ty>(Ty{1} << i)) != 0) { ++ret; }
+	}
+	return ret;
+}
+
+// constexpr fallback of detail::popcount: one iteration per set bit
+template <typename Ty>
+std::size_t count_clear_lowest(Ty bits) {
+	std::size_t ret{};
+	for (; bits != 0; bits &= static_cast<Ty>(bits - 1)) { ++ret; }
+	return ret;
+}
+
+template <typename EF>
+void popcount_intrinsic(benchmark::State& state) {
+	auto const& data = sample<EF>();
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) { ret += f.count(); }
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void popcount_per_bit(benchmark::State& state) {
+	using Ty = typename EF::value_type;
+	auto const& data = sample<EF>();
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) {
+			auto bits = static_cast<Ty>(f);
+			benchmark::DoNotOptimize(bits);
+			ret += count_per_bit(bits);
+		}
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+
+template <typename EF>
+void popcount_clear_lowest(benchmark::State& state) {
+	using Ty = typename EF::value_type;
+	auto const& data = sample<EF>();
+	for (auto _ : state) {
+		std::size_t ret{};
+		for (auto const& f : data) {
+			auto bits = static_cast<Ty>(f);
+			benchmark::DoNotOptimize(bits);
+			ret += count_clear_lowest(bits);
+		}
+		benchmark::DoNotOptimize(ret);
+	}
+	set_items(state, data.size());
+}
+} // namespace
+
+#define KT_BENCH_POPCOUNT(flags)                                                                                                                       \
+	BENCHMARK_TEMPLATE(popcount_intrinsic, flags<std::uint8_t>);                                                                                       \
+	BENCHMARK_TEMPLATE(popcount_intrinsic, flags<std::uint16_t>);                                                                                      \
+	BENCHMARK_TEMPLATE(popcount_intrinsic, flags<std::uint32_t>);                                                                                      \
+	BENCHMARK_TEMPLATE(popcount_intrinsic, flags<std::uint64_t>);                                                                                      \
+	BENCHMARK_TEMPLATE(popcount_per_bit, flags<std::uint8_t>);                                                                                         \
+	BENCHMARK_TEMPLATE(popcount_per_bit, flags<std::uint16_t>);                                                                                        \
+	BENCHMARK_TEMPLATE(popcount_per_bit, flags<std::uint32_t>);                                                                                        \
+	BENCHMARK_TEMPLATE(popcount_per_bit, flags<std::uint64_t>);                                                                                        \
+	BENCHMARK_TEMPLATE(popcount_clear_lowest, flags<std::uint8_t>);                                                                                    \
+	BENCHMARK_TEMPLATE(popcount_clear_lowest, flags<std::uint16_t>);                                                                                   \
+	BENCHMARK_TEMPLATE(popcount_clear_lowest, flags<std::uint32_t>);                                                                                   \
+	BENCHMARK_TEMPLATE(popcount_clear_lowest, flags<std::uint64_t>)
+
+KT_BENCH_POPCOUNT(linear_flags);
+KT_BENCH_POPCOUNT(uint_flags);
+} // namespace kt::bench
@@ -0,0 +1,254 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace kt::detail {
+///
+/// \brief Whether pext / pdep map to single BMI2 instructions on this target
+///
+#if defined(__BMI2__)
+inline constexpr bool has_bmi2_v = true;
+#else
+inline constexpr bool has_bmi2_v = false;
+#endif
+///
+/// \brief Whether popcount uses the MSVC POPCNT intrinsics (C++17 MSVC has no std::popcount / __builtin_popcount)
+/// POPCNT is assumed with /arch:AVX or later; define KT_FLAGS_POPCNT to assume it on other targets
+///
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86)) && (defined(__AVX__) || defined(KT_FLAGS_POPCNT))
+inline constexpr bool has_msvc_popcnt_v = true;
+#else
+inline constexpr bool has_msvc_popcnt_v = false;
+#endif
+
+///
+/// \brief Test whether the current evaluation is a constant expression (true if undetectable)
+///
+constexpr bool is_constant_evaluated() noexcept;
+///
+/// \brief Obtain number of set bits in t
+/// Non-integral storage must provide: std::size_t count() const
+///
+template <typename Ty>
+constexpr std::size_t popcount(Ty const& t) noexcept;
+///
+/// \brief Obtain index of lowest set bit in t (bit width of Ty if t is 0)
+/// Non-integral storage must provide: std::size_t countr_zero() const
+///
+template <typename Ty>
+constexpr std::size_t countr_zero(Ty const& t) noexcept;
+///
+/// \brief Obtain t with its lowest set bit cleared
+/// Non-integral storage must provide: Ty clear_lowest() const
+///
+template <typename Ty>
+constexpr Ty clear_lowest(Ty const& t) noexcept;
+///
+/// \brief Test if exactly one bit is set in t
+///
+template <typename Ty>
+constexpr bool has_single_bit(Ty const& t) noexcept;
+///
+/// \brief Obtain Ty with only bit at index set
+/// Non-integral storage must provide: set_bit(std::size_t)
+///
+template <typename Ty>
+constexpr Ty bit(std::size_t index) noexcept;
+///
+/// \brief Invoke func(std::size_t index) for each set bit in bits, lowest first
+///
+template <typename Ty, typename F>
+constexpr void for_each_bit(Ty bits, F&& func);
+///
+/// \brief Gather bits of value selected by mask into the low bits of the result (BMI2 pext when available)
+///
+template <typename Ty>
+constexpr Ty pext(Ty value, Ty mask) noexcept;
+///
+/// \brief Scatter the low bits of value into the positions selected by mask (BMI2 pdep when available)
+///
+template <typename Ty>
+constexpr Ty pdep(Ty value, Ty mask) noexcept;
+
+// impl
+
+constexpr bool is_constant_evaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+	return std::is_constant_evaluated();
+#elif defined(__GNUC__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+	return __builtin_is_constant_evaluated();
+#else
+	return true;
+#endif
+}
+
+template <typename Ty>
+constexpr std::size_t popcount(Ty const& t) noexcept {
+	if constexpr (!std::is_integral_v<Ty>) {
+		return t.count();
+	} else {
+		using U = std::make_unsigned_t<Ty>;
+		auto u = static_cast<U>(t);
+#if defined(__cpp_lib_bitops)
+		return static_cast<std::size_t>(std::popcount(u));
+#else
+#if defined(__GNUC__)
+		if (!is_constant_evaluated()) {
+			if constexpr (sizeof(U) <= sizeof(unsigned int)) {
+				return static_cast<std::size_t>(__builtin_popcount(u));
+			} else {
+				return static_cast<std::size_t>(__builtin_popcountll(u));
+			}
+		}
+#elif defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+		if constexpr (has_msvc_popcnt_v) {
+			if (!is_constant_evaluated()) {
+				if constexpr (sizeof(U) <= sizeof(unsigned short)) {
+					return static_cast<std::size_t>(__popcnt16(u));
+				} else if constexpr (sizeof(U) <= sizeof(unsigned int)) {
+					return static_cast<std::size_t>(__popcnt(u));
+				} else {
+#if defined(_M_X64)
+					return static_cast<std::size_t>(_mm_popcnt_u64(u));
+#else
+					return static_cast<std::size_t>(__popcnt(static_cast<unsigned int>(u)) + __popcnt(static_cast<unsigned int>(u >> 32)));
+#endif
+				}
+			}
+		}
+#endif
+		std::size_t ret{};
+		for (; u != 0; u &= static_cast<U>(u - 1)) { ++ret; }
+		return ret;
+#endif
+	}
+}
+
+template <typename Ty>
+constexpr std::size_t countr_zero(Ty const& t) noexcept {
+	if constexpr (!std::is_integral_v<Ty>) {
+		return t.countr_zero();
+	} else {
+		using U = std::make_unsigned_t<Ty>;
+		auto u = static_cast<U>(t);
+		if (u == 0) { return sizeof(U) * 8; }
+#if defined(__cpp_lib_bitops)
+		return static_cast<std::size_t>(std::countr_zero(u));
+#else
+#if defined(__GNUC__)
+		if (!is_constant_evaluated()) {
+			if constexpr (sizeof(U) <= sizeof(unsigned int)) {
+				return static_cast<std::size_t>(__builtin_ctz(u));
+			} else {
+				return static_cast<std::size_t>(__builtin_ctzll(u));
+			}
+		}
+#endif
+		std::size_t ret{};
+		for (; (u & 1) == 0; u >>= 1) { ++ret; }
+		return ret;
+#endif
+	}
+}
+
+template <typename Ty>
+constexpr Ty clear_lowest(Ty const& t) noexcept {
+	if constexpr (!std::is_integral_v<Ty>) {
+		return t.clear_lowest();
+	} else {
+		using U = std::make_unsigned_t<Ty>;
+		auto const u = static_cast<U>(t);
+		return static_cast<Ty>(u & static_cast<U>(u - 1));
+	}
+}
+
+template <typename Ty>
+constexpr bool has_single_bit(Ty const& t) noexcept {
+	if constexpr (!std::is_integral_v<Ty>) {
+		return t.count() == 1;
+	} else {
+		using U = std::make_unsigned_t<Ty>;
+		auto const u = static_cast<U>(t);
+#if defined(__cpp_lib_int_pow2)
+		return std::has_single_bit(u);
+#else
+		return u != 0 && (u & static_cast<U>(u - 1)) == 0;
+#endif
+	}
+}
+
+template <typename Ty>
+constexpr Ty bit(std::size_t index) noexcept {
+	if constexpr (!std::is_integral_v<Ty>) {
+		Ty ret{};
+		ret.set_bit(index);
+		return ret;
+	} else {
+		return static_cast<Ty>(static_cast<std::make_unsigned_t<Ty>>(1) << index);
+	}
+}
+
+template <typename Ty, typename F>
+constexpr void for_each_bit(Ty bits, F&& func) {
+	for (; bits != Ty{}; bits = clear_lowest(bits)) { func(countr_zero(bits)); }
+}
+
+template <typename Ty>
+constexpr Ty pext(Ty value, Ty mask) noexcept {
+	using U = std::make_unsigned_t<Ty>;
+	auto const v = static_cast<U>(value);
+	auto m = static_cast<U>(mask);
+#if defined(__BMI2__)
+	if (!is_constant_evaluated()) {
+		if constexpr (sizeof(U) <= sizeof(std::uint32_t)) {
+			return static_cast<Ty>(_pext_u32(v, m));
+#if defined(__x86_64__) || defined(_M_X64)
+		} else {
+			return static_cast<Ty>(_pext_u64(v, m));
+#endif
+		}
+	}
+#endif
+	U ret{};
+	for (U bit = 1; m != 0; m = static_cast<U>(m & static_cast<U>(m - 1)), bit = static_cast<U>(bit << 1)) {
+		if ((v & m & static_cast<U>(~m + 1)) != 0) { ret = static_cast<U>(ret | bit); }
+	}
+	return static_cast<Ty>(ret);
+}
+
+template <typename Ty>
+constexpr Ty pdep(Ty value, Ty mask) noexcept {
+	using U = std::make_unsigned_t<Ty>;
+	auto const v = static_cast<U>(value);
+	auto m = static_cast<U>(mask);
+#if defined(__BMI2__)
+	if (!is_constant_evaluated()) {
+		if constexpr (sizeof(U) <= sizeof(std::uint32_t)) {
+			return static_cast<Ty>(_pdep_u32(v, m));
+#if defined(__x86_64__) || defined(_M_X64)
+		} else {
+			return static_cast<Ty>(_pdep_u64(v, m));
+#endif
+		}
+	}
+#endif
+	U ret{};
+	for (U bit = 1; m != 0; m = static_cast<U>(m & static_cast<U>(m - 1)), bit = static_cast<U>(bit << 1)) {
+		if ((v & bit) != 0) { ret = static_cast<U>(ret | (m & static_cast<U>(~m + 1))); }
+	}
+	return static_cast<Ty>(ret);
+}
+} // namespace kt::detail
@@ -0,0 +1,482 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "bit_utils.hpp"
+#include "wide_bits.hpp"
+
+namespace kt {
+///
+/// \brief Non-owning read-only view over size() bits stored in 64-bit words (bits beyond size() must be zero)
+/// Obtained from basic_dynamic_flags, or over the storage of fixed flags whose words are 64 bit (uint64_t / wide_bits) without copying
+///
+class dynamic_flags_view {
+  public:
+	using word_t = std::uint64_t;
+
+	static constexpr std::size_t word_bits_v = sizeof(word_t) * 8;
+
+	struct const_iterator;
+	struct set_bit_range;
+
+	constexpr dynamic_flags_view() = default;
+	///
+	/// \brief View bits wide over words[0, (bits + 63) / 64)
+	///
+	constexpr dynamic_flags_view(word_t const* words, std::size_t bits) noexcept : m_words(words), m_size(bits) {}
+
+	///
+	/// \brief View the storage of fixed flags EF (enum_flags / uint_flags) in place; bit i of the storage is bit i
+	/// EF must be laid out as its storage, which must be std::uint64_t or wide_bits. The view is valid while flags lives
+	///
+	template <typename EF>
+	static dynamic_flags_view of(EF const& flags) noexcept;
+
+	constexpr std::size_t size() const noexcept { return m_size; }
+	constexpr std::size_t word_count() const noexcept { return words_for(m_size); }
+	constexpr word_t const* words() const noexcept { return m_words; }
+	///
+	/// \brief Obtain fixed flags EF holding the low bits (bits that do not fit are dropped)
+	///
+	template <typename EF>
+	EF to_flags() const noexcept;
+
+	///
+	/// \brief Test bit at index (false if out of range)
+	///
+	bool test(std::size_t index) const noexcept;
+	///
+	/// \brief Test if any bits are set
+	///
+	bool any() const noexcept;
+	///
+	/// \brief Test if any bits in mask are set
+	///
+	bool any(dynamic_flags_view mask) const noexcept;
+	///
+	/// \brief Test if all bits in mask are set
+	///
+	bool all(dynamic_flags_view mask) const noexcept;
+	///
+	/// \brief Obtain number of set bits
+	///
+	std::size_t count() const noexcept;
+	///
+	/// \brief Obtain a range over the index of each set bit
+	///
+	set_bit_range set_bits() const noexcept;
+
+	friend bool operator==(dynamic_flags_view lhs, dynamic_flags_view rhs) noexcept {
+		return lhs.m_size == rhs.m_size && std::equal(lhs.words(), lhs.words() + lhs.word_count(), rhs.words());
+	}
+	friend bool operator!=(dynamic_flags_view lhs, dynamic_flags_view rhs) noexcept { return !(lhs == rhs); }
+
+  private:
+	static constexpr std::size_t words_for(std::size_t bits) noexcept { return (bits + word_bits_v - 1) / word_bits_v; }
+
+	template <typename A>
+	friend class basic_dynamic_flags;
+
+	word_t const* m_words{};
+	std::size_t m_size{};
+};
+
+///
+/// \brief Forward iterator over the index of each set bit of a dynamic_flags_view / basic_dynamic_flags
+///
+struct dynamic_flags_view::const_iterator {
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using pointer = std::size_t const*;
+	using reference = std::size_t;
+
+	word_t const* words{};
+	std::size_t count{};
+	std::size_t index{};
+	word_t word{};
+
+	std::size_t operator*() const noexcept { return index * word_bits_v + detail::countr_zero(word); }
+	const_iterator& operator++() noexcept {
+		word = detail::clear_lowest(word);
+		skip();
+		return *this;
+	}
+	const_iterator operator++(int) noexcept {
+		auto ret = *this;
+		++(*this);
+		return ret;
+	}
+	///
+	/// \brief Advance to the next non-zero word (or end)
+	///
+	void skip() noexcept {
+		while (word == 0 && ++index < count) { word = words[index]; }
+		if (word == 0) { index = count; }
+	}
+
+	friend bool operator==(const_iterator const& lhs, const_iterator const& rhs) noexcept { return lhs.index == rhs.index && lhs.word == rhs.word; }
+	friend bool operator!=(const_iterator const& lhs, const_iterator const& rhs) noexcept { return !(lhs == rhs); }
+};
+
+///
+/// \brief Range over the set bits of a dynamic_flags_view / basic_dynamic_flags; costs one step per set bit plus one per word
+///
+struct dynamic_flags_view::set_bit_range {
+	word_t const* words{};
+	std::size_t count{};
+
+	const_iterator begin() const noexcept {
+		if (count == 0) { return end(); }
+		const_iterator ret{words, count, 0, words[0]};
+		ret.skip();
+		return ret;
+	}
+	const_iterator end() const noexcept { return {words, count, count, 0}; }
+	bool empty() const noexcept { return begin() == end(); }
+};
+
+///
+/// \brief Runtime sized flags: up to inline_bits_v bits are stored inline, wider sets allocate through Alloc
+/// Operations mirror t_enum_flags_ but take bit indices; all kernels are word-wise loops
+/// Bits beyond size() are always zero; binary operations treat missing words of the narrower operand as zero
+/// Use std::pmr::polymorphic_allocator<std::uint64_t> to allocate from a pool / arena
+///
+template <typename Alloc = std::allocator<std::uint64_t>>
+class basic_dynamic_flags {
+  public:
+	using word_t = dynamic_flags_view::word_t;
+	using allocator_type = Alloc;
+	using const_iterator = dynamic_flags_view::const_iterator;
+	using set_bit_range = dynamic_flags_view::set_bit_range;
+
+	static constexpr std::size_t word_bits_v = dynamic_flags_view::word_bits_v;
+	static constexpr std::size_t inline_words_v = 2;
+	static constexpr std::size_t inline_bits_v = inline_words_v * word_bits_v;
+
+	basic_dynamic_flags() = default;
+	///
+	/// \brief Construct bits wide with no bits set
+	///
+	explicit basic_dynamic_flags(std::size_t bits, Alloc const& alloc = Alloc());
+	basic_dynamic_flags(basic_dynamic_flags const& rhs);
+	basic_dynamic_flags(basic_dynamic_flags&& rhs) noexcept;
+	basic_dynamic_flags& operator=(basic_dynamic_flags const& rhs);
+	basic_dynamic_flags& operator=(basic_dynamic_flags&& rhs) noexcept;
+	~basic_dynamic_flags() { release(); }
+
+	///
+	/// \brief Copy the bits of view (allocates through alloc if wider than inline_bits_v)
+	///
+	explicit basic_dynamic_flags(dynamic_flags_view view, Alloc const& alloc = Alloc());
+
+	///
+	/// \brief Build a copy of fixed flags EF (enum_flags / uint_flags); bit i of the storage becomes bit i
+	/// Use dynamic_flags_view::of to read 64-bit / wide storage in place instead
+	///
+	template <typename EF>
+	static basic_dynamic_flags from_flags(EF const& flags, Alloc const& alloc = Alloc());
+	///
+	/// \brief Obtain fixed flags EF holding the low bits (bits that do not fit are dropped)
+	///
+	template <typename EF>
+	EF to_flags() const noexcept {
+		return view().template to_flags<EF>();
+	}
+
+	///
+	/// \brief Obtain a view over the current words (invalidated by resize / assignment / destruction)
+	///
+	dynamic_flags_view view() const noexcept { return {words(), m_size}; }
+	operator dynamic_flags_view() const noexcept { return view(); }
+
+	std::size_t size() const noexcept { return m_size; }
+	std::size_t word_count() const noexcept { return words_for(m_size); }
+	bool is_inline() const noexcept { return m_heap == nullptr; }
+	word_t const* words() const noexcept { return m_capacity > 0 ? m_heap : m_inline.data(); }
+	///
+	/// \brief Change width to bits; new bits are not set
+	///
+	void resize(std::size_t bits);
+
+	///
+	/// \brief Test bit at index (false if out of range)
+	///
+	bool test(std::size_t index) const noexcept { return view().test(index); }
+	///
+	/// \brief Set bits at indices (out of range indices are ignored)
+	///
+	template <typename... I>
+	basic_dynamic_flags& set(I... index) noexcept;
+	///
+	/// \brief Remove bits at indices
+	///
+	template <typename... I>
+	basic_dynamic_flags& reset(I... index) noexcept;
+	///
+	/// \brief Toggle bits at indices
+	///
+	template <typename... I>
+	basic_dynamic_flags& flip(I... index) noexcept;
+	///
+	/// \brief Remove all bits
+	///
+	basic_dynamic_flags& clear() noexcept;
+
+	///
+	/// \brief Test if any bits are set
+	///
+	bool any() const noexcept { return view().any(); }
+	///
+	/// \brief Test if any bits in mask are set
+	///
+	bool any(dynamic_flags_view mask) const noexcept { return view().any(mask); }
+	///
+	/// \brief Test if all bits in mask are set
+	///
+	bool all(dynamic_flags_view mask) const noexcept { return view().all(mask); }
+	///
+	/// \brief Obtain number of set bits
+	///
+	std::size_t count() const noexcept { return view().count(); }
+	///
+	/// \brief Obtain a range over the index of each set bit
+	///
+	set_bit_range set_bits() const noexcept { return view().set_bits(); }
+
+	basic_dynamic_flags& operator|=(dynamic_flags_view rhs) noexcept;
+	basic_dynamic_flags& operator&=(dynamic_flags_view rhs) noexcept;
+	basic_dynamic_flags& operator^=(dynamic_flags_view rhs) noexcept;
+
+	friend basic_dynamic_flags operator|(basic_dynamic_flags lhs, basic_dynamic_flags const& rhs) noexcept { return std::move(lhs |= rhs); }
+	friend basic_dynamic_flags operator&(basic_dynamic_flags lhs, basic_dynamic_flags const& rhs) noexcept { return std::move(lhs &= rhs); }
+	friend basic_dynamic_flags operator^(basic_dynamic_flags lhs, basic_dynamic_flags const& rhs) noexcept { return std::move(lhs ^= rhs); }
+	friend bool operator==(basic_dynamic_flags const& lhs, basic_dynamic_flags const& rhs) noexcept { return lhs.view() == rhs.view(); }
+	friend bool operator!=(basic_dynamic_flags const& lhs, basic_dynamic_flags const& rhs) noexcept { return !(lhs == rhs); }
+
+  private:
+	using alloc_traits = std::allocator_traits<Alloc>;
+
+	static constexpr std::size_t words_for(std::size_t bits) noexcept { return dynamic_flags_view::words_for(bits); }
+
+	// keyed on capacity (non-zero iff heap-backed) so the optimizer never sees a heap write land in m_inline
+	word_t* data() noexcept { return m_capacity > 0 ? m_heap : m_inline.data(); }
+	word_t top_mask() const noexcept;
+	void release() noexcept;
+	void copy_from(dynamic_flags_view rhs);
+
+	std::array<word_t, inline_words_v> m_inline{};
+	word_t* m_heap{};
+	std::size_t m_size{};
+	std::size_t m_capacity{};
+	Alloc m_alloc{};
+};
+
+using dynamic_flags = basic_dynamic_flags<>;
+
+// impl
+
+template <typename EF>
+dynamic_flags_view dynamic_flags_view::of(EF const& flags) noexcept {
+	using Ty = typename EF::value_type;
+	static_assert(sizeof(EF) == sizeof(Ty) && std::is_standard_layout_v<EF> && std::is_trivially_copyable_v<EF>, "EF must be laid out as its storage");
+	if constexpr (detail::is_wide_bits_v<Ty>) {
+		return {reinterpret_cast<word_t const*>(&flags), Ty::size_v};
+	} else {
+		static_assert(std::is_same_v<Ty, word_t>, "Storage must be std::uint64_t or wide_bits (use basic_dynamic_flags::from_flags to copy)");
+		return {reinterpret_cast<word_t const*>(&flags), word_bits_v};
+	}
+}
+template <typename EF>
+EF dynamic_flags_view::to_flags() const noexcept {
+	using Ty = typename EF::value_type;
+	auto const count = word_count();
+	if constexpr (detail::is_wide_bits_v<Ty>) {
+		Ty ret{};
+		std::copy(words(), words() + std::min(count, ret.words.size()), ret.words.begin());
+		return EF::from_value(ret);
+	} else {
+		return EF::from_value(count > 0 ? static_cast<Ty>(words()[0]) : Ty{});
+	}
+}
+inline bool dynamic_flags_view::test(std::size_t index) const noexcept {
+	return index < m_size && (m_words[index / word_bits_v] & (word_t{1} << (index % word_bits_v))) != 0;
+}
+inline bool dynamic_flags_view::any() const noexcept {
+	word_t ret{};
+	for (std::size_t i = 0; i < word_count(); ++i) { ret |= m_words[i]; }
+	return ret != 0;
+}
+inline bool dynamic_flags_view::any(dynamic_flags_view mask) const noexcept {
+	auto const count = std::min(word_count(), mask.word_count());
+	word_t ret{};
+	for (std::size_t i = 0; i < count; ++i) { ret |= m_words[i] & mask.m_words[i]; }
+	return ret != 0;
+}
+inline bool dynamic_flags_view::all(dynamic_flags_view mask) const noexcept {
+	auto const count = std::min(word_count(), mask.word_count());
+	word_t missing{};
+	for (std::size_t i = 0; i < count; ++i) { missing |= mask.m_words[i] & ~m_words[i]; }
+	for (std::size_t i = count; i < mask.word_count(); ++i) { missing |= mask.m_words[i]; }
+	return missing == 0;
+}
+inline std::size_t dynamic_flags_view::count() const noexcept {
+	std::size_t ret{};
+	for (std::size_t i = 0; i < word_count(); ++i) { ret += detail::popcount(m_words[i]); }
+	return ret;
+}
+inline dynamic_flags_view::set_bit_range dynamic_flags_view::set_bits() const noexcept { return {m_words, word_count()}; }
+
+template <typename Alloc>
+basic_dynamic_flags<Alloc>::basic_dynamic_flags(std::size_t bits, Alloc const& alloc) : m_alloc(alloc) {
+	resize(bits);
+}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>::basic_dynamic_flags(dynamic_flags_view view, Alloc const& alloc) : m_alloc(alloc) {
+	copy_from(view);
+}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>::basic_dynamic_flags(basic_dynamic_flags const& rhs) : m_alloc(alloc_traits::select_on_container_copy_construction(rhs.m_alloc)) {
+	copy_from(rhs);
+}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>::basic_dynamic_flags(basic_dynamic_flags&& rhs) noexcept
+	: m_inline(rhs.m_inline), m_heap(std::exchange(rhs.m_heap, nullptr)), m_size(std::exchange(rhs.m_size, 0)),
+	  m_capacity(std::exchange(rhs.m_capacity, 0)), m_alloc(std::move(rhs.m_alloc)) {}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::operator=(basic_dynamic_flags const& rhs) {
+	if (&rhs != this) { copy_from(rhs); }
+	return *this;
+}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::operator=(basic_dynamic_flags&& rhs) noexcept {
+	if (&rhs == this) { return *this; }
+	if (!rhs.m_heap || m_alloc == rhs.m_alloc) {
+		release();
+		m_inline = rhs.m_inline;
+		m_heap = std::exchange(rhs.m_heap, nullptr);
+		m_size = std::exchange(rhs.m_size, 0);
+		m_capacity = std::exchange(rhs.m_capacity, 0);
+	} else {
+		// allocators differ: reuse own storage (only allocates if rhs is wider than current capacity)
+		copy_from(rhs);
+	}
+	return *this;
+}
+template <typename Alloc>
+template <typename EF>
+basic_dynamic_flags<Alloc> basic_dynamic_flags<Alloc>::from_flags(EF const& flags, Alloc const& alloc) {
+	using Ty = typename EF::value_type;
+	auto const bits = static_cast<Ty>(flags);
+	if constexpr (detail::is_wide_bits_v<Ty>) {
+		basic_dynamic_flags ret(Ty::size_v, alloc);
+		std::copy(bits.words.begin(), bits.words.end(), ret.data());
+		return ret;
+	} else {
+		basic_dynamic_flags ret(sizeof(Ty) * 8, alloc);
+		ret.data()[0] = static_cast<word_t>(static_cast<std::make_unsigned_t<Ty>>(bits));
+		return ret;
+	}
+}
+template <typename Alloc>
+void basic_dynamic_flags<Alloc>::resize(std::size_t bits) {
+	auto const old_words = word_count();
+	auto const new_words = words_for(bits);
+	if (new_words > inline_words_v && new_words > m_capacity) {
+		word_t* heap = alloc_traits::allocate(m_alloc, new_words);
+		std::fill(heap, heap + new_words, word_t{});
+		std::copy(words(), words() + std::min(old_words, new_words), heap);
+		release();
+		m_heap = heap;
+		m_capacity = new_words;
+	} else if (new_words < old_words) {
+		std::fill(data() + new_words, data() + old_words, word_t{});
+	}
+	m_size = bits;
+	if (new_words > 0) { data()[new_words - 1] &= top_mask(); }
+}
+template <typename Alloc>
+void basic_dynamic_flags<Alloc>::copy_from(dynamic_flags_view rhs) {
+	clear();
+	resize(rhs.size());
+	std::copy(rhs.words(), rhs.words() + rhs.word_count(), data());
+}
+template <typename Alloc>
+void basic_dynamic_flags<Alloc>::release() noexcept {
+	if (m_heap) { alloc_traits::deallocate(m_alloc, m_heap, m_capacity); }
+	m_heap = nullptr;
+	m_capacity = 0;
+	m_inline = {};
+}
+template <typename Alloc>
+typename basic_dynamic_flags<Alloc>::word_t basic_dynamic_flags<Alloc>::top_mask() const noexcept {
+	auto const tail = m_size % word_bits_v;
+	return tail == 0 ? ~word_t{} : (word_t{1} << tail) - 1;
+}
+template <typename Alloc>
+template <typename... I>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::set(I... index) noexcept {
+	auto* const w = data();
+	auto const apply = [this, w](std::size_t i) {
+		if (i < m_size) { w[i / word_bits_v] |= word_t{1} << (i % word_bits_v); }
+	};
+	(apply(static_cast<std::size_t>(index)), ...);
+	return *this;
+}
+template <typename Alloc>
+template <typename... I>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::reset(I... index) noexcept {
+	auto* const w = data();
+	auto const apply = [this, w](std::size_t i) {
+		if (i < m_size) { w[i / word_bits_v] &= ~(word_t{1} << (i % word_bits_v)); }
+	};
+	(apply(static_cast<std::size_t>(index)), ...);
+	return *this;
+}
+template <typename Alloc>
+template <typename... I>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::flip(I... index) noexcept {
+	auto* const w = data();
+	auto const apply = [this, w](std::size_t i) {
+		if (i < m_size) { w[i / word_bits_v] ^= word_t{1} << (i % word_bits_v); }
+	};
+	(apply(static_cast<std::size_t>(index)), ...);
+	return *this;
+}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::clear() noexcept {
+	std::fill(data(), data() + word_count(), word_t{});
+	return *this;
+}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::operator|=(dynamic_flags_view rhs) noexcept {
+	auto const count = std::min(word_count(), rhs.word_count());
+	auto* const w = data();
+	for (std::size_t i = 0; i < count; ++i) { w[i] |= rhs.words()[i]; }
+	if (count > 0 && count == word_count()) { w[count - 1] &= top_mask(); }
+	return *this;
+}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::operator&=(dynamic_flags_view rhs) noexcept {
+	auto const count = std::min(word_count(), rhs.word_count());
+	auto* const w = data();
+	for (std::size_t i = 0; i < count; ++i) { w[i] &= rhs.words()[i]; }
+	std::fill(w + count, w + word_count(), word_t{});
+	return *this;
+}
+template <typename Alloc>
+basic_dynamic_flags<Alloc>& basic_dynamic_flags<Alloc>::operator^=(dynamic_flags_view rhs) noexcept {
+	auto const count = std::min(word_count(), rhs.word_count());
+	auto* const w = data();
+	for (std::size_t i = 0; i < count; ++i) { w[i] ^= rhs.words()[i]; }
+	if (count > 0 && count == word_count()) { w[count - 1] &= top_mask(); }
+	return *this;
+}
+} // namespace kt
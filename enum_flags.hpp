@@ -4,21 +4,54 @@
 #pragma once
 #include "enum_flags_crtp.hpp"
 #include "enum_traits.hpp"
+#include "enumerate_enum.hpp"
+#include "wide_bits.hpp"
 
 namespace kt {
 ///
-/// \brief Wrapper around an integral type used as bit flags
+/// \brief Opt-in per-enumerator usage counters: specialize as std::true_type (and include flag_counters.hpp) to enable
+/// Disabled instrumentation compiles to no code
+///
+template <typename Enum>
+struct instrument_flags : std::false_type {};
+template <typename Enum>
+struct flag_counters;
+
+namespace detail {
+template <typename Enum, typename Ty, typename Tr>
+struct enum_lut;
+template <typename Enum, typename Ty, Enum Begin, Enum End>
+struct enum_lut<Enum, Ty, enum_trait_lut<Begin, End>>;
+template <typename Enum, typename Ty>
+struct enum_lut<Enum, Ty, enum_trait_reflect>;
+
+template <typename Tr>
+struct is_lut_trait : std::false_type {};
+template <auto Begin, auto End>
+struct is_lut_trait<enum_trait_lut<Begin, End>> : std::true_type {};
+template <>
+struct is_lut_trait<enum_trait_reflect> : std::true_type {};
+} // namespace detail
+
+///
+/// \brief Wrapper around an integral type (or wide_bits) used as bit flags
 ///
 template <typename Enum, typename Ty = std::uint32_t, typename Tr = enum_trait_linear>
 class enum_flags : public detail::t_enum_flags_<enum_flags<Enum, Ty, Tr>, Ty> {
 	static_assert(std::is_enum_v<Enum>, "Enum must be an enum");
-	static_assert(std::is_integral_v<Ty>, "Ty must be integral");
-	static_assert(std::is_same_v<Tr, enum_trait_linear> || std::is_same_v<Tr, enum_trait_pot>, "Invalid enum trait");
+	static_assert(std::is_integral_v<Ty> || detail::is_wide_bits_v<Ty>, "Ty must be integral or wide_bits");
+	static_assert(std::is_same_v<Tr, enum_trait_linear> || std::is_same_v<Tr, enum_trait_pot> || detail::is_lut_trait<Tr>::value, "Invalid enum trait");
+	static_assert(!detail::is_wide_bits_v<Ty> || std::is_same_v<Tr, enum_trait_linear>, "wide_bits requires linear enums");
+#if defined(KT_FLAGS_CONCEPTS)
+	static_assert(flag_enum<Enum> && (std::integral<Ty> || flag_storage<Ty>), "Invalid flag storage");
+#endif
 
   public:
 	using type = Enum;
 	using storage_t = Ty;
+	using bit_type = Enum;
 	static constexpr bool is_linear_v = std::is_same_v<Tr, enum_trait_linear>;
+	static constexpr bool is_lut_v = detail::is_lut_trait<Tr>::value;
 
 	///
 	/// \brief Default constructor
@@ -45,7 +78,7 @@ class enum_flags : public detail::t_enum_flags_<enum_flags<Enum, Ty, Tr>, Ty> {
 	///
 	/// \brief Test for flag
 	///
-	constexpr bool test(Enum flag) const noexcept { return this->all(flag); }
+	constexpr bool test(Enum flag) const noexcept;
 	///
 	/// \brief Test for flag
 	///
@@ -53,19 +86,124 @@ class enum_flags : public detail::t_enum_flags_<enum_flags<Enum, Ty, Tr>, Ty> {
 
   private:
 	constexpr Ty& get_ty() noexcept { return m_bits; }
+	static constexpr Enum to_bit(std::size_t index) noexcept;
+	static void record(flag_hook hook, enum_flags mask) noexcept { flag_counters<Enum>::record(hook, mask.m_bits); }
 
 	Ty m_bits{};
 
 	template <typename T, typename U>
 	friend struct detail::t_enum_flags_;
+	friend struct set_bit_iterator<enum_flags>;
 };
 
+///
+/// \brief enum_flags backed by wide_bits sized from enumerate_enum::size() (for linear enums of any size)
+///
+template <typename Enum>
+using wide_flags = enum_flags<Enum, wide_bits<wide_words(enumerate_enum<Enum>::size())>>;
+
+namespace detail {
+template <typename Enum, typename Tr>
+struct auto_storage;
+
+template <typename Enum, typename Ty, typename Tr>
+inline constexpr bool is_instrumented_v<enum_flags<Enum, Ty, Tr>> = instrument_flags<Enum>::value;
+} // namespace detail
+
+///
+/// \brief enum_flags backed by the smallest storage that can hold every enumerator of Enum
+/// Bit count obtained from enumerate_enum (Enum::eCOUNT_ or enum_reflect); uses wide_bits beyond 64 linear enumerators
+/// Use enum_trait_reflect to allot bits only to the enumerators that exist
+///
+template <typename Enum, typename Tr = enum_trait_linear>
+using auto_flags = enum_flags<Enum, typename detail::auto_storage<Enum, Tr>::type, Tr>;
+
 // impl
 
+namespace detail {
+template <typename Enum, typename Ty, Enum Begin, Enum End>
+struct enum_lut<Enum, Ty, enum_trait_lut<Begin, End>> {
+	using enumerate_t = enumerate_enum<Enum, Begin, End>;
+	using u_type = typename enumerate_t::u_type;
+
+	static_assert(enumerate_t::size() <= sizeof(Ty) * 8, "Ty too small for enum range");
+
+	static constexpr std::array<Enum, enumerate_t::size()> values = enumerate_t::values();
+
+	// contiguous range: the bit index is the offset from Begin, no table needed
+	static constexpr Ty mask(Enum e) noexcept { return bit<Ty>(static_cast<std::size_t>(static_cast<u_type>(e) - static_cast<u_type>(Begin))); }
+	static constexpr Enum to_bit(std::size_t index) noexcept { return static_cast<Enum>(static_cast<u_type>(Begin) + static_cast<u_type>(index)); }
+};
+
+template <typename Enum, typename Ty>
+struct enum_lut<Enum, Ty, enum_trait_reflect> {
+	using reflect_t = enum_reflect<Enum>;
+	using u_type = typename reflect_t::u_type;
+
+	static_assert(reflect_t::count_v <= sizeof(Ty) * 8, "Ty too small for enum range");
+
+	static constexpr std::array<Enum, reflect_t::count_v> values = reflect_t::values_v;
+	// indexed by underlying value; gaps map to no bits
+	static constexpr std::array<Ty, static_cast<std::size_t>(reflect_t::end_v)> masks = [] {
+		std::array<Ty, static_cast<std::size_t>(reflect_t::end_v)> ret{};
+		for (std::size_t i = 0; i < values.size(); ++i) { ret[static_cast<std::size_t>(static_cast<u_type>(values[i]))] = bit<Ty>(i); }
+		return ret;
+	}();
+
+	static constexpr Ty mask(Enum e) noexcept { return masks[static_cast<std::size_t>(static_cast<u_type>(e))]; }
+	static constexpr Enum to_bit(std::size_t index) noexcept { return values[index]; }
+};
+
+template <typename Enum, typename Tr>
+struct auto_storage {
+	static constexpr std::size_t bits_v = [] {
+		if constexpr (std::is_same_v<Tr, enum_trait_pot>) {
+			return enumerate_enum<Enum, static_cast<Enum>(1), enum_end_v<Enum, Tr>, Tr>::size();
+		} else if constexpr (std::is_same_v<Tr, enum_trait_reflect>) {
+			return enum_reflect<Enum>::count_v;
+		} else {
+			return enumerate_enum<Enum>::size();
+		}
+	}();
+
+	template <std::size_t Bits>
+	static constexpr auto select() noexcept {
+		if constexpr (Bits <= 8) {
+			return std::uint8_t{};
+		} else if constexpr (Bits <= 16) {
+			return std::uint16_t{};
+		} else if constexpr (Bits <= 32) {
+			return std::uint32_t{};
+		} else if constexpr (Bits <= 64) {
+			return std::uint64_t{};
+		} else {
+			return wide_bits<wide_words(Bits)>{};
+		}
+	}
+
+	using type = decltype(select<bits_v>());
+
+	static constexpr std::size_t capacity_v = [] {
+		if constexpr (is_wide_bits_v<type>) {
+			return type::size_v;
+		} else {
+			return sizeof(type) * 8;
+		}
+	}();
+
+	static_assert(capacity_v >= bits_v, "Selected storage is too small");
+};
+} // namespace detail
+
+
 template <typename Enum, typename Ty, typename Tr>
 constexpr enum_flags<Enum, Ty, Tr>::enum_flags(Enum e) noexcept {
-	if constexpr (is_linear_v) {
-		m_bits |= (1 << static_cast<Ty>(e));
+	if constexpr (detail::is_wide_bits_v<Ty>) {
+		m_bits.set_bit(static_cast<std::size_t>(e));
+	} else if constexpr (is_linear_v) {
+		m_bits |= detail::bit<Ty>(static_cast<std::size_t>(e));
+	} else if constexpr (is_lut_v) {
+		m_bits |= detail::enum_lut<Enum, Ty, Tr>::mask(e);
 	} else {
 		m_bits |= static_cast<Ty>(e);
 	}
@@ -73,7 +211,7 @@ constexpr enum_flags<Enum, Ty, Tr>::enum_flags(Enum e) noexcept {
 template <typename Enum, typename Ty, typename Tr>
 template <typename... T>
 constexpr enum_flags<Enum, Ty, Tr>::enum_flags(T... t) noexcept {
-	this->set(t...);
+	(update(t), ...);
 }
 template <typename Enum, typename Ty, typename Tr>
 constexpr enum_flags<Enum, Ty, Tr>& enum_flags<Enum, Ty, Tr>::update(enum_flags set, enum_flags unset) noexcept {
@@ -81,4 +219,24 @@ constexpr enum_flags<Enum, Ty, Tr>& enum_flags<Enum, Ty, Tr>::update(enum_flags
 	m_bits &= ~unset.m_bits;
 	return *this;
 }
+template <typename Enum, typename Ty, typename Tr>
+constexpr bool enum_flags<Enum, Ty, Tr>::test(Enum flag) const noexcept {
+	if constexpr (detail::is_instrumented_v<enum_flags>) {
+		if (!detail::is_constant_evaluated()) { record(flag_hook::test, flag); }
+		enum_flags const mask(flag);
+		return (m_bits & mask.m_bits) == mask.m_bits;
+	} else {
+		return this->all(flag);
+	}
+}
+template <typename Enum, typename Ty, typename Tr>
+constexpr Enum enum_flags<Enum, Ty, Tr>::to_bit(std::size_t index) noexcept {
+	if constexpr (is_linear_v) {
+		return static_cast<Enum>(index);
+	} else if constexpr (is_lut_v) {
+		return detail::enum_lut<Enum, Ty, Tr>::to_bit(index);
+	} else {
+		return static_cast<Enum>(detail::bit<Ty>(index));
+	}
+}
 } // namespace kt
@@ -4,14 +4,65 @@
 #pragma once
 #include <cstdint>
 #include <type_traits>
+#include "bit_utils.hpp"
+#include "flag_ops.hpp"
+#include "flag_ranges.hpp"
+// define KT_FLAGS_NO_CONCEPTS to keep the C++17 path under C++20
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L && __has_include(<concepts>) && !defined(KT_FLAGS_NO_CONCEPTS)
+#include <concepts>
+#define KT_FLAGS_CONCEPTS
+#endif
+
+namespace kt {
+///
+/// \brief Mask of inputs T... for flags type EF, computed at compile time
+///
+template <typename EF, auto... T>
+inline constexpr EF mask_v = EF::make(T...);
+
+///
+/// \brief Operations reported to flag_counters when instrumentation is enabled
+///
+enum class flag_hook { set, reset, test, any, all, eCOUNT_ };
+
+#if defined(KT_FLAGS_CONCEPTS)
+///
+/// \brief Enum usable as flags
+///
+template <typename T>
+concept flag_enum = std::is_enum_v<T>;
+///
+/// \brief Flag storage: unsigned integer, or multi-word type providing bitwise ops, count(), countr_zero(), clear_lowest() and set_bit()
+///
+template <typename T>
+concept flag_storage = std::unsigned_integral<T> || (std::regular<T> && requires(T t, T const& c, std::size_t i) {
+	{ c.count() } -> std::convertible_to<std::size_t>;
+	{ c.countr_zero() } -> std::convertible_to<std::size_t>;
+	{ c.clear_lowest() } -> std::same_as<T>;
+	t.set_bit(i);
+	{ c | c } -> std::same_as<T>;
+	{ c & c } -> std::same_as<T>;
+	{ c ^ c } -> std::same_as<T>;
+	{ ~c } -> std::same_as<T>;
+});
+#endif
+} // namespace kt
 
 namespace kt::detail {
+///
+/// \brief Whether EF reports set / reset / test / any / all (specialized by concrete flags types)
+///
+template <typename EF>
+inline constexpr bool is_instrumented_v = false;
+
 ///
 /// \brief CRTP base type for concrete flags
 /// Requirements:
 ///  - [explicit] operator Ty() const noexcept
 ///  - EF& update(T, U) noexcept
 ///  - Ty& get_ty() noexcept
+///  - static bit_type to_bit(std::size_t) noexcept
+///  - static void record(flag_hook, EF) (if is_instrumented_v<EF>)
 ///
 template <typename EF, typename Ty>
 struct t_enum_flags_ {
@@ -24,6 +75,10 @@ struct t_enum_flags_ {
 	template <typename... T>
 	static constexpr EF make(T... t) noexcept;
 	///
+	/// \brief Build an instance from raw storage (inverse of static_cast<Ty>)
+	///
+	static constexpr EF from_value(Ty value) noexcept;
+	///
 	/// \brief Set inputs
 	///
 	template <typename... T>
@@ -34,10 +89,31 @@ struct t_enum_flags_ {
 	template <typename... T>
 	constexpr EF& reset(T... t) noexcept;
 	///
+	/// \brief Set compile-time inputs (single precomputed mask)
+	///
+	template <auto T, auto... U>
+	constexpr EF& set() noexcept {
+		if constexpr (is_instrumented_v<EF>) { record(flag_hook::set, mask_v<EF, T, U...>); }
+		return to_ef().update(mask_v<EF, T, U...>);
+	}
+	///
+	/// \brief Remove compile-time inputs (single precomputed mask)
+	///
+	template <auto T, auto... U>
+	constexpr EF& reset() noexcept {
+		if constexpr (is_instrumented_v<EF>) { record(flag_hook::reset, mask_v<EF, T, U...>); }
+		return to_ef().update(EF{}, mask_v<EF, T, U...>);
+	}
+	///
 	/// \brief Assign value to mask bits
 	///
 	template <typename T>
 	constexpr EF& assign(T mask, bool gvalue) noexcept;
+	///
+	/// \brief Apply a chain of set / reset / flip steps in one pass: apply(kt::set(a) | kt::reset(b))
+	///
+	template <typename... S>
+	constexpr EF& apply(flag_ops<S...> const& ops) noexcept;
 
 	///
 	/// \brief Test if any bits are set
@@ -53,10 +129,52 @@ struct t_enum_flags_ {
 	///
 	template <typename T>
 	constexpr bool all(T mask) const noexcept;
+#if defined(KT_FLAGS_CONCEPTS)
+	///
+	/// \brief Test if any bits in mask are set (no make() round trip)
+	///
+	constexpr bool any(EF const& mask) const noexcept;
+	///
+	/// \brief Test if all bits in mask are set (no make() round trip)
+	///
+	constexpr bool all(EF const& mask) const noexcept;
+#endif
+	///
+	/// \brief Test if any compile-time inputs are set (single precomputed mask)
+	///
+	template <auto T, auto... U>
+	constexpr bool any() const noexcept {
+		if constexpr (is_instrumented_v<EF>) { record(flag_hook::any, mask_v<EF, T, U...>); }
+		return (to_ty() & mask_v<EF, T, U...>.to_ty()) != Ty{};
+	}
+	///
+	/// \brief Test if all compile-time inputs are set (single precomputed mask)
+	///
+	template <auto T, auto... U>
+	constexpr bool all() const noexcept {
+		if constexpr (is_instrumented_v<EF>) { record(flag_hook::all, mask_v<EF, T, U...>); }
+		return (to_ty() & mask_v<EF, T, U...>.to_ty()) == mask_v<EF, T, U...>.to_ty();
+	}
 	///
 	/// \brief Obtain number of set bits
 	///
 	constexpr std::size_t count() const noexcept;
+	///
+	/// \brief Test if exactly one bit is set
+	///
+	constexpr bool has_single_bit() const noexcept { return detail::has_single_bit(to_ty()); }
+	///
+	/// \brief Obtain a range over each set bit
+	///
+	constexpr set_bit_range<EF> set_bits() const noexcept { return {to_ty()}; }
+	///
+	/// \brief Obtain a range over every subset of set bits (2^count() values, ending with the empty set)
+	///
+	constexpr subset_range<EF> subsets() const noexcept;
+	///
+	/// \brief Obtain a range over every superset of set bits within universe (ascending)
+	///
+	constexpr superset_range<EF> supersets_within(EF universe) const noexcept;
 
 	///
 	/// \brief Compare two t_enum_flags_
@@ -82,6 +200,20 @@ struct t_enum_flags_ {
 	///
 	template <typename T>
 	constexpr EF& operator^=(T mask) noexcept;
+#if defined(KT_FLAGS_CONCEPTS)
+	///
+	/// \brief Perform bitwise OR / add flags (no make() round trip)
+	///
+	constexpr EF& operator|=(EF const& mask) noexcept;
+	///
+	/// \brief Perform bitwise AND / multiply flags (no make() round trip)
+	///
+	constexpr EF& operator&=(EF const& mask) noexcept;
+	///
+	/// \brief Perform bitwise XOR / exclusively add flags (no make() round trip)
+	///
+	constexpr EF& operator^=(EF const& mask) noexcept;
+#endif
 
 	///
 	/// \brief Perform bitwise OR / add flags
@@ -101,6 +233,9 @@ struct t_enum_flags_ {
 	constexpr EF const& to_ef() const noexcept { return static_cast<EF const&>(*this); }
 	constexpr Ty to_ty() const noexcept { return static_cast<Ty>(to_ef()); }
 	constexpr Ty& get_ty() noexcept { return to_ef().get_ty(); }
+	static constexpr void record(flag_hook hook, EF const& mask) noexcept {
+		if (!is_constant_evaluated()) { EF::record(hook, mask); }
+	}
 };
 
 // impl
@@ -113,8 +248,15 @@ constexpr EF t_enum_flags_<EF, Ty>::make(T... t) noexcept {
 	return ret;
 }
 template <typename EF, typename Ty>
+constexpr EF t_enum_flags_<EF, Ty>::from_value(Ty value) noexcept {
+	EF ret{};
+	ret.get_ty() = value;
+	return ret;
+}
+template <typename EF, typename Ty>
 template <typename... T>
 constexpr EF& t_enum_flags_<EF, Ty>::set(T... t) noexcept {
+	if constexpr (is_instrumented_v<EF>) { record(flag_hook::set, make(t...)); }
 	auto& ret = to_ef();
 	(ret.update(t), ...);
 	return ret;
@@ -122,8 +264,9 @@ constexpr EF& t_enum_flags_<EF, Ty>::set(T... t) noexcept {
 template <typename EF, typename Ty>
 template <typename... T>
 constexpr EF& t_enum_flags_<EF, Ty>::reset(T... t) noexcept {
+	if constexpr (is_instrumented_v<EF>) { record(flag_hook::reset, make(t...)); }
 	auto& ret = to_ef();
-	(ret.update({}, t), ...);
+	(ret.update(EF{}, t), ...);
 	return to_ef();
 }
 template <typename EF, typename Ty>
@@ -137,25 +280,53 @@ constexpr EF& t_enum_flags_<EF, Ty>::assign(T mask, bool get_ty) noexcept {
 	return to_ef();
 }
 template <typename EF, typename Ty>
+template <typename... S>
+constexpr EF& t_enum_flags_<EF, Ty>::apply(flag_ops<S...> const& ops) noexcept {
+	auto const affine = ops.template resolve<EF>();
+	get_ty() = static_cast<Ty>((to_ty() & affine.keep.to_ty()) ^ affine.toggle.to_ty());
+	return to_ef();
+}
+template <typename EF, typename Ty>
 template <typename T>
 constexpr bool t_enum_flags_<EF, Ty>::any(T mask) const noexcept {
+	if constexpr (is_instrumented_v<EF>) { record(flag_hook::any, make(mask)); }
 	return (to_ty() & make(mask).to_ty()) != Ty{};
 }
 template <typename EF, typename Ty>
 template <typename T>
 constexpr bool t_enum_flags_<EF, Ty>::all(T mask) const noexcept {
+	if constexpr (is_instrumented_v<EF>) { record(flag_hook::all, make(mask)); }
 	EF const& t = make(mask);
 	return (to_ty() & t.to_ty()) == t.to_ty();
 }
+#if defined(KT_FLAGS_CONCEPTS)
+template <typename EF, typename Ty>
+constexpr bool t_enum_flags_<EF, Ty>::any(EF const& mask) const noexcept {
+	if constexpr (is_instrumented_v<EF>) { record(flag_hook::any, mask); }
+	return (to_ty() & mask.to_ty()) != Ty{};
+}
+template <typename EF, typename Ty>
+constexpr bool t_enum_flags_<EF, Ty>::all(EF const& mask) const noexcept {
+	if constexpr (is_instrumented_v<EF>) { record(flag_hook::all, mask); }
+	return (to_ty() & mask.to_ty()) == mask.to_ty();
+}
+#endif
 template <typename EF, typename Ty>
 constexpr std::size_t t_enum_flags_<EF, Ty>::count() const noexcept {
-	std::size_t ret{};
-	Ty bit = static_cast<Ty>(1);
-	for (std::size_t i = 0; i < sizeof(Ty) * 8; ++i) {
-		if ((to_ty() & bit) != 0) { ++ret; }
-		bit <<= 1;
-	}
-	return ret;
+	return detail::popcount(to_ty());
+}
+template <typename EF, typename Ty>
+constexpr subset_range<EF> t_enum_flags_<EF, Ty>::subsets() const noexcept {
+	using U = typename subset_range<EF>::const_iterator::uint_t;
+	auto const mask = static_cast<U>(to_ty());
+	return {{mask, mask, {}, false}};
+}
+template <typename EF, typename Ty>
+constexpr superset_range<EF> t_enum_flags_<EF, Ty>::supersets_within(EF universe) const noexcept {
+	using U = typename superset_range<EF>::const_iterator::uint_t;
+	auto const base = static_cast<U>(to_ty() & universe.to_ty());
+	auto const free = static_cast<U>(universe.to_ty() & static_cast<Ty>(~to_ty()));
+	return {{U{}, free, base, false}};
 }
 template <typename EF, typename Ty>
 template <typename T>
@@ -175,4 +346,21 @@ constexpr EF& t_enum_flags_<EF, Ty>::operator^=(T mask) noexcept {
 	get_ty() ^= make(mask).to_ty();
 	return to_ef();
 }
+#if defined(KT_FLAGS_CONCEPTS)
+template <typename EF, typename Ty>
+constexpr EF& t_enum_flags_<EF, Ty>::operator|=(EF const& mask) noexcept {
+	get_ty() |= mask.to_ty();
+	return to_ef();
+}
+template <typename EF, typename Ty>
+constexpr EF& t_enum_flags_<EF, Ty>::operator&=(EF const& mask) noexcept {
+	get_ty() &= mask.to_ty();
+	return to_ef();
+}
+template <typename EF, typename Ty>
+constexpr EF& t_enum_flags_<EF, Ty>::operator^=(EF const& mask) noexcept {
+	get_ty() ^= mask.to_ty();
+	return to_ef();
+}
+#endif
 } // namespace kt::detail
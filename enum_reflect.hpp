@@ -0,0 +1,271 @@
+// KT header-only library
+// Requirements: C++17, GCC / Clang / MSVC (__PRETTY_FUNCTION__ / __FUNCSIG__)
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "enum_traits.hpp"
+#include "flag_names.hpp"
+
+///
+/// \brief Number of candidate values probed by enum_reflect for linear enums ([0, KT_ENUM_REFLECT_MAX))
+///
+#if !defined(KT_ENUM_REFLECT_MAX)
+#define KT_ENUM_REFLECT_MAX 128
+#endif
+
+namespace kt {
+namespace detail {
+template <typename Enum, typename = void>
+struct has_count_sentinel : std::false_type {};
+template <typename Enum>
+struct has_count_sentinel<Enum, std::void_t<decltype(Enum::eCOUNT_)>> : std::true_type {};
+
+template <typename Tr>
+struct lut_range : std::false_type {};
+template <auto Begin, auto End>
+struct lut_range<enum_trait_lut<Begin, End>> : std::true_type {
+	static constexpr auto begin_v = Begin;
+	static constexpr auto end_v = End;
+};
+} // namespace detail
+
+///
+/// \brief Compile-time detection of valid enumerators, their names and gaps
+/// Probes each candidate value (linear: [0, KT_ENUM_REFLECT_MAX), pot: each bit of the underlying type) through the compiler's function signature
+/// Enum should have a fixed underlying type (all scoped enums do)
+/// If Enum has an eCOUNT_ sentinel, it and every value at or above it are not enumerators
+/// Tr is the trait of the enum_flags layout names() describes; every trait but enum_trait_pot probes linearly
+///
+template <typename Enum, typename Tr = enum_trait_linear>
+struct enum_reflect {
+	static_assert(std::is_enum_v<Enum>, "Enum must be an enum");
+
+	using u_type = std::underlying_type_t<Enum>;
+
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr bool is_pot_v = std::is_same_v<Tr, enum_trait_pot>;
+	static constexpr bool is_reflect_v = std::is_same_v<Tr, enum_trait_reflect>;
+
+	static_assert(std::is_same_v<Tr, enum_trait_linear> || is_pot_v || is_reflect_v || detail::lut_range<Tr>::value, "Invalid enum trait");
+	///
+	/// \brief Number of candidate values probed
+	///
+	static constexpr std::size_t scan_v = [] {
+		constexpr std::size_t bits_v = sizeof(u_type) * 8 - (std::is_signed_v<u_type> ? 1 : 0);
+		if constexpr (is_pot_v) {
+			return bits_v;
+		} else if constexpr (bits_v < 16) {
+			return std::size_t{1} << bits_v < std::size_t{KT_ENUM_REFLECT_MAX} ? std::size_t{1} << bits_v : std::size_t{KT_ENUM_REFLECT_MAX};
+		} else {
+			return std::size_t{KT_ENUM_REFLECT_MAX};
+		}
+	}();
+
+	///
+	/// \brief Obtain name of e (empty if e is not a named enumerator within the scan)
+	///
+	static constexpr std::string_view name(Enum e) noexcept;
+	///
+	/// \brief Obtain index of e in values_v (npos if e is not a named enumerator within the scan)
+	///
+	static constexpr std::size_t index_of(Enum e) noexcept;
+	///
+	/// \brief Test if e is a named enumerator within the scan
+	///
+	static constexpr bool is_valid(Enum e) noexcept { return index_of(e) != npos; }
+
+  private:
+	static constexpr Enum probe_value(std::size_t index) noexcept;
+	static constexpr std::size_t probe_index(Enum e) noexcept;
+	static constexpr bool below_sentinel(Enum e) noexcept;
+	template <std::size_t... I>
+	static constexpr std::array<std::string_view, scan_v> scan(std::index_sequence<I...>) noexcept;
+
+	static constexpr std::array<std::string_view, scan_v> probed_v = scan(std::make_index_sequence<scan_v>());
+
+  public:
+	///
+	/// \brief Number of valid enumerators
+	///
+	static constexpr std::size_t count_v = [] {
+		std::size_t ret{};
+		for (auto const name : probed_v) { ret += name.empty() ? 0 : 1; }
+		return ret;
+	}();
+	///
+	/// \brief Valid enumerators in ascending order
+	///
+	static constexpr std::array<Enum, count_v> values_v = [] {
+		std::array<Enum, count_v> ret{};
+		std::size_t count{};
+		for (std::size_t i = 0; i < scan_v; ++i) {
+			if (!probed_v[i].empty()) { ret[count++] = probe_value(i); }
+		}
+		return ret;
+	}();
+	///
+	/// \brief Names of values_v
+	///
+	static constexpr std::array<std::string_view, count_v> names_v = [] {
+		std::array<std::string_view, count_v> ret{};
+		for (std::size_t i = 0; i < count_v; ++i) { ret[i] = probed_v[probe_index(values_v[i])]; }
+		return ret;
+	}();
+	///
+	/// \brief One past the last valid enumerator (linear: max + 1, pot: max << 1)
+	///
+	static constexpr Enum end_v = count_v == 0 ? probe_value(0) : probe_value(probe_index(values_v[count_v - 1]) + 1);
+	///
+	/// \brief Number of candidate values below end_v that are not enumerators
+	///
+	static constexpr std::size_t gaps_v = (count_v == 0 ? 0 : probe_index(values_v[count_v - 1]) + 1) - count_v;
+	///
+	/// \brief Whether enumerators are contiguous from the first candidate (0 / 1)
+	///
+	static constexpr bool is_dense_v = gaps_v == 0;
+
+	///
+	/// \brief Number of bits used by enum_flags<Enum, Ty, Tr> (linear / pot: one past the last enumerator's bit, reflect: count_v, lut: End - Begin)
+	///
+	static constexpr std::size_t bits_v = [] {
+		if constexpr (is_reflect_v) {
+			return count_v;
+		} else if constexpr (detail::lut_range<Tr>::value) {
+			return static_cast<std::size_t>(static_cast<u_type>(detail::lut_range<Tr>::end_v) - static_cast<u_type>(detail::lut_range<Tr>::begin_v));
+		} else {
+			return count_v + gaps_v;
+		}
+	}();
+
+	///
+	/// \brief Obtain a flag_names table indexed by bit position in enum_flags<Enum, Ty, Tr> (bits of gaps have empty names)
+	///
+	static constexpr flag_names<bits_v> names() noexcept;
+};
+
+namespace detail {
+///
+/// \brief Signature of this function names V (or spells it as a cast if V is not an enumerator)
+///
+template <auto V>
+constexpr std::string_view reflect_signature() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	return __FUNCSIG__;
+#else
+	return __PRETTY_FUNCTION__;
+#endif
+}
+
+///
+/// \brief Obtain unqualified name of V, or an empty view if V is not an enumerator
+///
+template <auto V>
+constexpr std::string_view reflect_name() noexcept {
+	std::string_view str = reflect_signature<V>();
+#if defined(_MSC_VER) && !defined(__clang__)
+	// "... reflect_signature<E::a>(void)"
+	auto const first = str.find("reflect_signature<");
+	if (first == std::string_view::npos) { return {}; }
+	str = str.substr(first + 18);
+	str = str.substr(0, str.rfind(">(void)"));
+#else
+	// GCC: "... [with auto V = E::a; ...]", Clang: "... [V = E::a]"
+	auto const first = str.find("V = ");
+	if (first == std::string_view::npos) { return {}; }
+	str = str.substr(first + 4);
+	str = str.substr(0, str.find_first_of(";]"));
+#endif
+	// values that are not enumerators are printed as casts / numbers: "(E)5", "(enum E)0x5", "5"
+	if (str.empty() || str[0] == '(' || str[0] == '-' || (str[0] >= '0' && str[0] <= '9')) { return {}; }
+	auto const scope = str.rfind(':');
+	return scope == std::string_view::npos ? str : str.substr(scope + 1);
+}
+
+///
+/// \brief Enum::eCOUNT_ if present, else one past the last reflected enumerator
+///
+template <typename Enum, typename Tr = enum_trait_linear>
+constexpr Enum enum_end() noexcept {
+	if constexpr (has_count_sentinel<Enum>::value) {
+		return Enum::eCOUNT_;
+	} else {
+		return enum_reflect<Enum, Tr>::end_v;
+	}
+}
+
+template <typename Enum, typename Tr = enum_trait_linear>
+inline constexpr Enum enum_end_v = enum_end<Enum, Tr>();
+} // namespace detail
+
+// impl
+
+template <typename Enum, typename Tr>
+constexpr Enum enum_reflect<Enum, Tr>::probe_value(std::size_t index) noexcept {
+	if constexpr (is_pot_v) {
+		using uint_t = std::make_unsigned_t<u_type>;
+		return index < sizeof(u_type) * 8 ? static_cast<Enum>(static_cast<u_type>(uint_t{1} << index)) : Enum{};
+	} else {
+		return static_cast<Enum>(static_cast<u_type>(index));
+	}
+}
+template <typename Enum, typename Tr>
+constexpr std::size_t enum_reflect<Enum, Tr>::probe_index(Enum e) noexcept {
+	if constexpr (is_pot_v) {
+		using uint_t = std::make_unsigned_t<u_type>;
+		auto const bits = static_cast<uint_t>(e);
+		// not a single bit: out of scan
+		if (bits == 0 || (bits & (bits - 1)) != 0) { return scan_v; }
+		return detail::countr_zero(bits);
+	} else {
+		auto const value = static_cast<u_type>(e);
+		if constexpr (std::is_signed_v<u_type>) {
+			if (value < 0) { return scan_v; }
+		}
+		return static_cast<std::size_t>(value) < scan_v ? static_cast<std::size_t>(value) : scan_v;
+	}
+}
+template <typename Enum, typename Tr>
+constexpr bool enum_reflect<Enum, Tr>::below_sentinel(Enum e) noexcept {
+	if constexpr (detail::has_count_sentinel<Enum>::value) {
+		return static_cast<u_type>(e) < static_cast<u_type>(Enum::eCOUNT_);
+	} else {
+		return true;
+	}
+}
+template <typename Enum, typename Tr>
+template <std::size_t... I>
+constexpr std::array<std::string_view, enum_reflect<Enum, Tr>::scan_v> enum_reflect<Enum, Tr>::scan(std::index_sequence<I...>) noexcept {
+	return {(below_sentinel(probe_value(I)) ? detail::reflect_name<probe_value(I)>() : std::string_view())...};
+}
+template <typename Enum, typename Tr>
+constexpr std::string_view enum_reflect<Enum, Tr>::name(Enum e) noexcept {
+	auto const index = probe_index(e);
+	return index < scan_v ? probed_v[index] : std::string_view();
+}
+template <typename Enum, typename Tr>
+constexpr flag_names<enum_reflect<Enum, Tr>::bits_v> enum_reflect<Enum, Tr>::names() noexcept {
+	std::array<std::string_view, bits_v> ret{};
+	for (std::size_t i = 0; i < bits_v; ++i) {
+		if constexpr (is_reflect_v) {
+			ret[i] = names_v[i];
+		} else if constexpr (detail::lut_range<Tr>::value) {
+			ret[i] = name(static_cast<Enum>(static_cast<u_type>(static_cast<u_type>(detail::lut_range<Tr>::begin_v) + i)));
+		} else {
+			ret[i] = probed_v[i];
+		}
+	}
+	return flag_names<bits_v>(ret);
+}
+template <typename Enum, typename Tr>
+constexpr std::size_t enum_reflect<Enum, Tr>::index_of(Enum e) noexcept {
+	auto const index = probe_index(e);
+	if (index >= scan_v || probed_v[index].empty()) { return npos; }
+	std::size_t ret{};
+	for (std::size_t i = 0; i < index; ++i) { ret += probed_v[i].empty() ? 0 : 1; }
+	return ret;
+}
+} // namespace kt
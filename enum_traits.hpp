@@ -9,4 +9,13 @@ struct enum_trait_linear {};
 /// \brief Trait for power of two enums (1, 2, 4, 8, ...)
 ///
 struct enum_trait_pot {};
+///
+/// \brief Trait for linear enums in [Begin, End) mapped to bits (0, 1, 2, ...) by their offset from Begin
+///
+template <auto Begin, auto End = decltype(Begin)::eCOUNT_>
+struct enum_trait_lut {};
+///
+/// \brief Trait for enums with gaps: enumerators detected by enum_reflect mapped to bits (0, 1, 2, ...) in ascending order
+///
+struct enum_trait_reflect {};
 } // namespace kt
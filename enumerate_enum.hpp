@@ -2,11 +2,14 @@
 #include <array>
 #include <iterator>
 #include <type_traits>
+#include "bit_utils.hpp"
+#include "enum_reflect.hpp"
 #include "enum_traits.hpp"
 
 namespace kt {
 ///
-/// \brief Iterator for an enum value
+/// \brief Random access iterator for an enum value
+/// Advancing is an add (linear) or a shift (pot); distance is a subtraction or a difference of trailing zero counts
 ///
 template <typename Enum, typename Tr>
 struct enum_iterator;
@@ -15,10 +18,10 @@ struct enum_iterator;
 /// \brief (Stateless) container for values of an Enum and its given range
 /// \param Enum enum to iterate over
 /// \param Begin start value of enum (0 by default)
-/// \param End one past the last valid value (Enum::eCOUNT_ by default)
+/// \param End one past the last valid value (Enum::eCOUNT_ by default, else one past the last enumerator found by enum_reflect)
 /// \param Tr enum_trait_linear or enum_trait_pot (linear by default)
 ///
-template <typename Enum, Enum Begin = static_cast<Enum>(0), Enum End = Enum::eCOUNT_, typename Tr = enum_trait_linear>
+template <typename Enum, Enum Begin = static_cast<Enum>(0), Enum End = detail::enum_end_v<Enum>, typename Tr = enum_trait_linear>
 struct enumerate_enum {
 	static_assert(std::is_enum_v<Enum>, "Enum must be an enum");
 
@@ -45,9 +48,8 @@ struct enumerate_enum {
 	/// \brief Obtain all values of represented range in an array
 	///
 	static constexpr std::array<Enum, size()> values() noexcept {
-		std::array<Enum, size()> ret;
-		std::size_t i = 0;
-		for (auto const e : enumerate_enum<Enum, Begin, End, Tr>()) { ret[i++] = e; }
+		std::array<Enum, size()> ret{};
+		for (std::size_t i = 0; i < ret.size(); ++i) { ret[i] = begin()[static_cast<std::ptrdiff_t>(i)]; }
 		return ret;
 	}
 };
@@ -58,8 +60,11 @@ template <typename Enum, typename Tr>
 struct enum_iterator {
 	static_assert(std::is_enum_v<Enum>, "Enum must be an enum");
 
-	using iterator_category = std::bidirectional_iterator_tag;
+	using iterator_category = std::random_access_iterator_tag;
 	using value_type = Enum;
+	using difference_type = std::ptrdiff_t;
+	using pointer = Enum const*;
+	using reference = Enum;
 	using u_type = std::underlying_type_t<Enum>;
 
 	static constexpr bool is_pot_v = std::is_same_v<Tr, enum_trait_pot>;
@@ -69,46 +74,63 @@ struct enum_iterator {
 	Enum value{};
 
 	constexpr value_type operator*() const noexcept { return value; }
-	constexpr enum_iterator& operator++() noexcept {
-		if constexpr (is_pot_v) {
-			value = static_cast<Enum>(static_cast<u_type>(value) << 1);
-		} else {
-			value = static_cast<Enum>(static_cast<u_type>(value) + 1);
-		}
-		return *this;
-		;
-	}
+	constexpr value_type operator[](difference_type n) const noexcept { return *(*this + n); }
+
+	constexpr enum_iterator& operator+=(difference_type n) noexcept;
+	constexpr enum_iterator& operator-=(difference_type n) noexcept { return *this += -n; }
+
+	constexpr enum_iterator& operator++() noexcept { return *this += 1; }
 	constexpr enum_iterator operator++(int) noexcept {
 		auto ret = *this;
 		++(*this);
 		return ret;
 	}
-	constexpr enum_iterator& operator--() noexcept {
-		if constexpr (is_pot_v) {
-			value = static_cast<Enum>(static_cast<u_type>(value) >> 1);
-		} else {
-			value = static_cast<Enum>(static_cast<u_type>(value) - 1);
-		}
-		return *this;
-	}
+	constexpr enum_iterator& operator--() noexcept { return *this -= 1; }
 	constexpr enum_iterator operator--(int) noexcept {
 		auto ret = *this;
 		--(*this);
 		return ret;
 	}
 
+	friend constexpr enum_iterator operator+(enum_iterator it, difference_type n) noexcept { return it += n; }
+	friend constexpr enum_iterator operator+(difference_type n, enum_iterator it) noexcept { return it += n; }
+	friend constexpr enum_iterator operator-(enum_iterator it, difference_type n) noexcept { return it -= n; }
+	friend constexpr difference_type operator-(enum_iterator lhs, enum_iterator rhs) noexcept { return lhs.index() - rhs.index(); }
+
 	friend constexpr bool operator==(enum_iterator lhs, enum_iterator rhs) noexcept { return lhs.value == rhs.value; }
 	friend constexpr bool operator!=(enum_iterator lhs, enum_iterator rhs) noexcept { return !(lhs == rhs); }
+	friend constexpr bool operator<(enum_iterator lhs, enum_iterator rhs) noexcept { return lhs - rhs < 0; }
+	friend constexpr bool operator>(enum_iterator lhs, enum_iterator rhs) noexcept { return rhs < lhs; }
+	friend constexpr bool operator<=(enum_iterator lhs, enum_iterator rhs) noexcept { return !(rhs < lhs); }
+	friend constexpr bool operator>=(enum_iterator lhs, enum_iterator rhs) noexcept { return !(lhs < rhs); }
+
+  private:
+	// position of value: bit index (pot; a value shifted out past the top bit is the width) or underlying value (linear)
+	constexpr difference_type index() const noexcept;
 };
 
-template <typename Enum, Enum Begin, Enum End, typename Tr>
-constexpr std::size_t enumerate_enum<Enum, Begin, End, Tr>::size() noexcept {
-	if constexpr (std::is_same_v<Tr, enum_trait_pot>) {
-		std::size_t ret{};
-		for (auto begin = Begin; begin != End; begin = static_cast<Enum>(static_cast<u_type>(begin) << 1)) { ++ret; }
-		return ret;
+template <typename Enum, typename Tr>
+constexpr enum_iterator<Enum, Tr>& enum_iterator<Enum, Tr>::operator+=(difference_type n) noexcept {
+	if constexpr (is_pot_v) {
+		constexpr auto width_v = static_cast<difference_type>(sizeof(u_type) * 8);
+		auto const bit = index() + n;
+		value = static_cast<Enum>(bit >= 0 && bit < width_v ? static_cast<u_type>(u_type{1} << bit) : u_type{});
 	} else {
-		return static_cast<std::size_t>(End) - static_cast<std::size_t>(Begin);
+		value = static_cast<Enum>(static_cast<u_type>(static_cast<difference_type>(value) + n));
 	}
+	return *this;
+}
+template <typename Enum, typename Tr>
+constexpr typename enum_iterator<Enum, Tr>::difference_type enum_iterator<Enum, Tr>::index() const noexcept {
+	if constexpr (is_pot_v) {
+		return static_cast<difference_type>(detail::countr_zero(static_cast<u_type>(value)));
+	} else {
+		return static_cast<difference_type>(value);
+	}
+}
+
+template <typename Enum, Enum Begin, Enum End, typename Tr>
+constexpr std::size_t enumerate_enum<Enum, Begin, End, Tr>::size() noexcept {
+	return static_cast<std::size_t>(end() - begin());
 }
 } // namespace kt
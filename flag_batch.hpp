@@ -0,0 +1,197 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include "bit_utils.hpp"
+
+///
+/// \brief Annotate batch kernels with #pragma omp simd: on under -fopenmp, or define KT_FLAGS_OPENMP_SIMD and build with -fopenmp-simd
+///
+#if (defined(_OPENMP) || defined(KT_FLAGS_OPENMP_SIMD)) && (!defined(_MSC_VER) || defined(__clang__))
+#define KT_FLAGS_DETAIL_OMP_SIMD 1
+#define KT_FLAGS_DETAIL_PRAGMA(x) _Pragma(#x)
+#define KT_FLAGS_DETAIL_SIMD(clause) KT_FLAGS_DETAIL_PRAGMA(omp simd clause)
+#else
+#define KT_FLAGS_DETAIL_OMP_SIMD 0
+#define KT_FLAGS_DETAIL_SIMD(clause)
+#endif
+
+namespace kt {
+///
+/// \brief Set mask bits in each of data[0, count)
+///
+template <typename EF>
+constexpr void batch_set(EF* data, std::size_t count, EF mask) noexcept;
+///
+/// \brief Remove mask bits from each of data[0, count)
+///
+template <typename EF>
+constexpr void batch_reset(EF* data, std::size_t count, EF mask) noexcept;
+///
+/// \brief Toggle mask bits in each of data[0, count)
+///
+template <typename EF>
+constexpr void batch_flip(EF* data, std::size_t count, EF mask) noexcept;
+///
+/// \brief Obtain number of elements in data[0, count) that have all bits in mask set
+///
+template <typename EF>
+constexpr std::size_t batch_count_all(EF const* data, std::size_t count, EF mask) noexcept;
+///
+/// \brief Obtain number of elements in data[0, count) that have any bits in mask set
+///
+template <typename EF>
+constexpr std::size_t batch_count_any(EF const* data, std::size_t count, EF mask) noexcept;
+///
+/// \brief Test if any element in data[0, count) has any bits in mask set
+///
+template <typename EF>
+constexpr bool batch_any_mask(EF const* data, std::size_t count, EF mask) noexcept;
+///
+/// \brief Obtain bitwise OR of all elements in data[0, count)
+///
+template <typename EF>
+constexpr EF reduce_or(EF const* data, std::size_t count) noexcept;
+///
+/// \brief Obtain bitwise AND of all elements in data[0, count) (all bits set if count is 0)
+///
+template <typename EF>
+constexpr EF reduce_and(EF const* data, std::size_t count) noexcept;
+
+// impl
+
+namespace detail {
+///
+/// \brief Layout guarantee for batch kernels: EF is exactly its storage and safely copyable as such
+///
+template <typename EF>
+constexpr bool is_flat_flags_v = sizeof(EF) == sizeof(typename EF::value_type) && std::is_trivially_copyable_v<EF> && std::is_standard_layout_v<EF>;
+
+///
+/// \brief Whether kernels dispatch to the omp simd loops below at run time (omp simd is not allowed in constant evaluation)
+///
+inline constexpr bool has_omp_simd_v = KT_FLAGS_DETAIL_OMP_SIMD != 0;
+
+template <typename EF, typename Op>
+void simd_transform(EF* data, std::size_t count, Op op) noexcept {
+	using Ty = typename EF::value_type;
+	KT_FLAGS_DETAIL_SIMD()
+	for (std::size_t i = 0; i < count; ++i) { data[i] = EF::from_value(op(static_cast<Ty>(data[i]))); }
+}
+template <typename EF, typename Pred>
+std::size_t simd_count(EF const* data, std::size_t count, Pred pred) noexcept {
+	using Ty = typename EF::value_type;
+	std::size_t ret{};
+	KT_FLAGS_DETAIL_SIMD(reduction(+ : ret))
+	for (std::size_t i = 0; i < count; ++i) { ret += static_cast<std::size_t>(pred(static_cast<Ty>(data[i]))); }
+	return ret;
+}
+template <typename EF>
+typename EF::value_type simd_or(EF const* data, std::size_t count) noexcept {
+	using Ty = typename EF::value_type;
+	Ty ret{};
+	KT_FLAGS_DETAIL_SIMD(reduction(| : ret))
+	for (std::size_t i = 0; i < count; ++i) { ret |= static_cast<Ty>(data[i]); }
+	return ret;
+}
+template <typename EF>
+typename EF::value_type simd_and(EF const* data, std::size_t count) noexcept {
+	using Ty = typename EF::value_type;
+	auto ret = static_cast<Ty>(~Ty{});
+	KT_FLAGS_DETAIL_SIMD(reduction(& : ret))
+	for (std::size_t i = 0; i < count; ++i) { ret &= static_cast<Ty>(data[i]); }
+	return ret;
+}
+} // namespace detail
+
+// Kernels are branchless loops over raw storage. Clang and MSVC vectorize them at -O2 / /O2; GCC vectorizes them at -O3, or at -O2
+// through the omp simd loops (KT_FLAGS_OPENMP_SIMD): its -O2 cost model rejects them otherwise
+
+template <typename EF>
+constexpr void batch_set(EF* data, std::size_t count, EF mask) noexcept {
+	using Ty = typename EF::value_type;
+	static_assert(detail::is_flat_flags_v<EF>, "Invalid flags layout");
+	auto const m = static_cast<Ty>(mask);
+	if constexpr (detail::has_omp_simd_v) {
+		if (!detail::is_constant_evaluated()) { return detail::simd_transform(data, count, [m](Ty t) { return static_cast<Ty>(t | m); }); }
+	}
+	for (std::size_t i = 0; i < count; ++i) { data[i] = EF::from_value(static_cast<Ty>(static_cast<Ty>(data[i]) | m)); }
+}
+template <typename EF>
+constexpr void batch_reset(EF* data, std::size_t count, EF mask) noexcept {
+	using Ty = typename EF::value_type;
+	static_assert(detail::is_flat_flags_v<EF>, "Invalid flags layout");
+	auto const m = static_cast<Ty>(~static_cast<Ty>(mask));
+	if constexpr (detail::has_omp_simd_v) {
+		if (!detail::is_constant_evaluated()) { return detail::simd_transform(data, count, [m](Ty t) { return static_cast<Ty>(t & m); }); }
+	}
+	for (std::size_t i = 0; i < count; ++i) { data[i] = EF::from_value(static_cast<Ty>(static_cast<Ty>(data[i]) & m)); }
+}
+template <typename EF>
+constexpr void batch_flip(EF* data, std::size_t count, EF mask) noexcept {
+	using Ty = typename EF::value_type;
+	static_assert(detail::is_flat_flags_v<EF>, "Invalid flags layout");
+	auto const m = static_cast<Ty>(mask);
+	if constexpr (detail::has_omp_simd_v) {
+		if (!detail::is_constant_evaluated()) { return detail::simd_transform(data, count, [m](Ty t) { return static_cast<Ty>(t ^ m); }); }
+	}
+	for (std::size_t i = 0; i < count; ++i) { data[i] = EF::from_value(static_cast<Ty>(static_cast<Ty>(data[i]) ^ m)); }
+}
+template <typename EF>
+constexpr std::size_t batch_count_all(EF const* data, std::size_t count, EF mask) noexcept {
+	using Ty = typename EF::value_type;
+	static_assert(detail::is_flat_flags_v<EF>, "Invalid flags layout");
+	auto const m = static_cast<Ty>(mask);
+	if constexpr (detail::has_omp_simd_v) {
+		if (!detail::is_constant_evaluated()) { return detail::simd_count(data, count, [m](Ty t) { return (t & m) == m; }); }
+	}
+	std::size_t ret{};
+	for (std::size_t i = 0; i < count; ++i) { ret += static_cast<std::size_t>((static_cast<Ty>(data[i]) & m) == m); }
+	return ret;
+}
+template <typename EF>
+constexpr std::size_t batch_count_any(EF const* data, std::size_t count, EF mask) noexcept {
+	using Ty = typename EF::value_type;
+	static_assert(detail::is_flat_flags_v<EF>, "Invalid flags layout");
+	auto const m = static_cast<Ty>(mask);
+	if constexpr (detail::has_omp_simd_v) {
+		if (!detail::is_constant_evaluated()) { return detail::simd_count(data, count, [m](Ty t) { return (t & m) != Ty{}; }); }
+	}
+	std::size_t ret{};
+	for (std::size_t i = 0; i < count; ++i) { ret += static_cast<std::size_t>((static_cast<Ty>(data[i]) & m) != Ty{}); }
+	return ret;
+}
+template <typename EF>
+constexpr bool batch_any_mask(EF const* data, std::size_t count, EF mask) noexcept {
+	using Ty = typename EF::value_type;
+	return (static_cast<Ty>(reduce_or(data, count)) & static_cast<Ty>(mask)) != Ty{};
+}
+template <typename EF>
+constexpr EF reduce_or(EF const* data, std::size_t count) noexcept {
+	using Ty = typename EF::value_type;
+	static_assert(detail::is_flat_flags_v<EF>, "Invalid flags layout");
+	if constexpr (detail::has_omp_simd_v) {
+		if (!detail::is_constant_evaluated()) { return EF::from_value(detail::simd_or(data, count)); }
+	}
+	Ty ret{};
+	for (std::size_t i = 0; i < count; ++i) { ret |= static_cast<Ty>(data[i]); }
+	return EF::from_value(ret);
+}
+template <typename EF>
+constexpr EF reduce_and(EF const* data, std::size_t count) noexcept {
+	using Ty = typename EF::value_type;
+	static_assert(detail::is_flat_flags_v<EF>, "Invalid flags layout");
+	if constexpr (detail::has_omp_simd_v) {
+		if (!detail::is_constant_evaluated()) { return EF::from_value(detail::simd_and(data, count)); }
+	}
+	auto ret = static_cast<Ty>(~Ty{});
+	for (std::size_t i = 0; i < count; ++i) { ret &= static_cast<Ty>(data[i]); }
+	return EF::from_value(ret);
+}
+} // namespace kt
+
+#undef KT_FLAGS_DETAIL_SIMD
+#undef KT_FLAGS_DETAIL_PRAGMA
+#undef KT_FLAGS_DETAIL_OMP_SIMD
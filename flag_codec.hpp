@@ -0,0 +1,247 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace kt {
+///
+/// \brief Bytes required to encode one EF as raw storage
+///
+template <typename EF>
+constexpr std::size_t raw_size_v = sizeof(typename EF::value_type);
+///
+/// \brief Maximum bytes required to encode one EF as a varint
+///
+template <typename EF>
+constexpr std::size_t varint_max_size_v = (sizeof(typename EF::value_type) * 8 + 6) / 7;
+
+// Raw and varint encoders return bytes written and decoders return bytes read; 0 indicates insufficient / malformed input
+// Varint decoders accept only canonical encodings (as written by the encoders): no bits beyond the storage width, no over-long forms
+
+///
+/// \brief Encode flags as little-endian raw storage
+///
+template <typename EF>
+constexpr std::size_t encode_raw(EF flags, std::uint8_t* buf, std::size_t size) noexcept;
+///
+/// \brief Decode little-endian raw storage into out
+///
+template <typename EF>
+constexpr std::size_t decode_raw(std::uint8_t const* buf, std::size_t size, EF& out) noexcept;
+///
+/// \brief Encode count flags as little-endian raw storage
+///
+template <typename EF>
+constexpr std::size_t encode_raw(EF const* data, std::size_t count, std::uint8_t* buf, std::size_t size) noexcept;
+///
+/// \brief Decode count flags from little-endian raw storage
+///
+template <typename EF>
+constexpr std::size_t decode_raw(std::uint8_t const* buf, std::size_t size, EF* out, std::size_t count) noexcept;
+
+///
+/// \brief Encode flags as LEB128 varint
+///
+template <typename EF>
+constexpr std::size_t encode_varint(EF flags, std::uint8_t* buf, std::size_t size) noexcept;
+///
+/// \brief Decode LEB128 varint into out
+///
+template <typename EF>
+constexpr std::size_t decode_varint(std::uint8_t const* buf, std::size_t size, EF& out) noexcept;
+///
+/// \brief Encode count flags as LEB128 varints
+///
+template <typename EF>
+constexpr std::size_t encode_varint(EF const* data, std::size_t count, std::uint8_t* buf, std::size_t size) noexcept;
+///
+/// \brief Decode count flags from LEB128 varints
+///
+template <typename EF>
+constexpr std::size_t decode_varint(std::uint8_t const* buf, std::size_t size, EF* out, std::size_t count) noexcept;
+
+// Delta codecs return std::nullopt on insufficient / malformed input: an empty batch (count == 0) encodes to 0 bytes
+
+///
+/// \brief Encode data[i] ^ prev[i] for count flags; runs of unchanged flags collapse into one varint
+/// Layout: repeated [varint zero run length][varint non-zero delta] (last delta omitted if the run reaches count)
+///
+template <typename EF>
+constexpr std::optional<std::size_t> encode_delta(EF const* data, EF const* prev, std::size_t count, std::uint8_t* buf, std::size_t size) noexcept;
+///
+/// \brief Decode output of encode_delta against prev into out (out may alias prev)
+///
+template <typename EF>
+constexpr std::optional<std::size_t> decode_delta(std::uint8_t const* buf, std::size_t size, EF const* prev, EF* out, std::size_t count) noexcept;
+
+// impl
+
+namespace detail {
+template <typename EF>
+struct codec_storage {
+	static_assert(std::is_integral_v<typename EF::value_type>, "Codecs require integral storage");
+	using type = std::make_unsigned_t<typename EF::value_type>;
+};
+template <typename EF>
+using codec_uint_t = typename codec_storage<EF>::type;
+
+template <typename U>
+constexpr std::size_t write_varint(U value, std::uint8_t* buf, std::size_t size) noexcept {
+	std::size_t ret{};
+	do {
+		if (ret == size) { return 0; }
+		auto byte = static_cast<std::uint8_t>(value & 0x7f);
+		value = static_cast<U>(value >> 7);
+		if (value != 0) { byte |= 0x80; }
+		buf[ret++] = byte;
+	} while (value != 0);
+	return ret;
+}
+///
+/// \brief Test if byte may appear at index (< max size) of a canonical varint of U
+/// Rejects payload bits beyond the width of U and zero final bytes after the first (over-long encodings)
+///
+template <typename U>
+constexpr bool is_valid_varint_byte(std::uint8_t byte, std::size_t index) noexcept {
+	constexpr std::size_t bits_v = sizeof(U) * 8;
+	std::size_t const free = bits_v - 7 * index;
+	if (free < 7 && ((byte & 0x7f) >> free) != 0) { return false; }
+	return index == 0 || byte != 0;
+}
+template <typename U>
+constexpr std::size_t read_varint(std::uint8_t const* buf, std::size_t size, U& out) noexcept {
+	constexpr std::size_t max_size_v = (sizeof(U) * 8 + 6) / 7;
+	U value{};
+	for (std::size_t i = 0; i < size && i < max_size_v; ++i) {
+		if (!is_valid_varint_byte<U>(buf[i], i)) { return 0; }
+		value |= static_cast<U>(static_cast<U>(buf[i] & 0x7f) << (7 * i));
+		if ((buf[i] & 0x80) == 0) {
+			out = value;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+} // namespace detail
+
+template <typename EF>
+constexpr std::size_t encode_raw(EF flags, std::uint8_t* buf, std::size_t size) noexcept {
+	using U = detail::codec_uint_t<EF>;
+	if (size < sizeof(U)) { return 0; }
+	auto value = static_cast<U>(static_cast<typename EF::value_type>(flags));
+	for (std::size_t i = 0; i < sizeof(U); ++i) {
+		buf[i] = static_cast<std::uint8_t>(value & 0xff);
+		value = static_cast<U>(value >> 8);
+	}
+	return sizeof(U);
+}
+template <typename EF>
+constexpr std::size_t decode_raw(std::uint8_t const* buf, std::size_t size, EF& out) noexcept {
+	using U = detail::codec_uint_t<EF>;
+	if (size < sizeof(U)) { return 0; }
+	U value{};
+	for (std::size_t i = 0; i < sizeof(U); ++i) { value |= static_cast<U>(static_cast<U>(buf[i]) << (8 * i)); }
+	out = EF::from_value(static_cast<typename EF::value_type>(value));
+	return sizeof(U);
+}
+template <typename EF>
+constexpr std::size_t encode_raw(EF const* data, std::size_t count, std::uint8_t* buf, std::size_t size) noexcept {
+	if (size / raw_size_v<EF> < count) { return 0; }
+	for (std::size_t i = 0; i < count; ++i) { encode_raw(data[i], buf + i * raw_size_v<EF>, raw_size_v<EF>); }
+	return count * raw_size_v<EF>;
+}
+template <typename EF>
+constexpr std::size_t decode_raw(std::uint8_t const* buf, std::size_t size, EF* out, std::size_t count) noexcept {
+	if (size / raw_size_v<EF> < count) { return 0; }
+	for (std::size_t i = 0; i < count; ++i) { decode_raw(buf + i * raw_size_v<EF>, raw_size_v<EF>, out[i]); }
+	return count * raw_size_v<EF>;
+}
+
+template <typename EF>
+constexpr std::size_t encode_varint(EF flags, std::uint8_t* buf, std::size_t size) noexcept {
+	using U = detail::codec_uint_t<EF>;
+	return detail::write_varint(static_cast<U>(static_cast<typename EF::value_type>(flags)), buf, size);
+}
+template <typename EF>
+constexpr std::size_t decode_varint(std::uint8_t const* buf, std::size_t size, EF& out) noexcept {
+	using U = detail::codec_uint_t<EF>;
+	U value{};
+	auto const ret = detail::read_varint(buf, size, value);
+	if (ret > 0) { out = EF::from_value(static_cast<typename EF::value_type>(value)); }
+	return ret;
+}
+template <typename EF>
+constexpr std::size_t encode_varint(EF const* data, std::size_t count, std::uint8_t* buf, std::size_t size) noexcept {
+	std::size_t ret{};
+	for (std::size_t i = 0; i < count; ++i) {
+		auto const written = encode_varint(data[i], buf + ret, size - ret);
+		if (written == 0) { return 0; }
+		ret += written;
+	}
+	return ret;
+}
+template <typename EF>
+constexpr std::size_t decode_varint(std::uint8_t const* buf, std::size_t size, EF* out, std::size_t count) noexcept {
+	std::size_t ret{};
+	for (std::size_t i = 0; i < count; ++i) {
+		auto const read = decode_varint(buf + ret, size - ret, out[i]);
+		if (read == 0) { return 0; }
+		ret += read;
+	}
+	return ret;
+}
+
+template <typename EF>
+constexpr std::optional<std::size_t> encode_delta(EF const* data, EF const* prev, std::size_t count, std::uint8_t* buf, std::size_t size) noexcept {
+	using Ty = typename EF::value_type;
+	using U = detail::codec_uint_t<EF>;
+	std::size_t ret{};
+	std::size_t run{};
+	for (std::size_t i = 0; i < count; ++i) {
+		auto const delta = static_cast<U>(static_cast<Ty>(data[i]) ^ static_cast<Ty>(prev[i]));
+		if (delta == 0) {
+			++run;
+			continue;
+		}
+		auto written = detail::write_varint(run, buf + ret, size - ret);
+		if (written == 0) { return std::nullopt; }
+		ret += written;
+		written = detail::write_varint(delta, buf + ret, size - ret);
+		if (written == 0) { return std::nullopt; }
+		ret += written;
+		run = 0;
+	}
+	if (run > 0) {
+		auto const written = detail::write_varint(run, buf + ret, size - ret);
+		if (written == 0) { return std::nullopt; }
+		ret += written;
+	}
+	return ret;
+}
+template <typename EF>
+constexpr std::optional<std::size_t> decode_delta(std::uint8_t const* buf, std::size_t size, EF const* prev, EF* out, std::size_t count) noexcept {
+	using Ty = typename EF::value_type;
+	using U = detail::codec_uint_t<EF>;
+	std::size_t ret{};
+	std::size_t i{};
+	while (i < count) {
+		std::size_t run{};
+		auto read = detail::read_varint(buf + ret, size - ret, run);
+		if (read == 0 || run > count - i) { return std::nullopt; }
+		ret += read;
+		for (std::size_t const end = i + run; i < end; ++i) { out[i] = prev[i]; }
+		if (i == count) { break; }
+		U delta{};
+		read = detail::read_varint(buf + ret, size - ret, delta);
+		if (read == 0) { return std::nullopt; }
+		ret += read;
+		out[i] = EF::from_value(static_cast<Ty>(static_cast<Ty>(prev[i]) ^ static_cast<Ty>(delta)));
+		++i;
+	}
+	return ret;
+}
+} // namespace kt
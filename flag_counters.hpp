@@ -0,0 +1,96 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include "enum_flags.hpp"
+
+namespace kt {
+///
+/// \brief Process-wide relaxed atomic counters of set / reset / test / any / all per enumerator bit
+/// Enable for an Enum by specializing instrument_flags:
+///   template <> struct kt::instrument_flags<MyEnum> : std::true_type {};
+///
+template <typename Enum>
+struct flag_counters {
+	static constexpr std::size_t bits_v = 256;
+	static constexpr std::size_t hooks_v = static_cast<std::size_t>(flag_hook::eCOUNT_);
+
+	using counts_t = std::array<std::uint64_t, hooks_v>;
+
+	///
+	/// \brief Increment hook counter of each set bit in bits (bits beyond bits_v are ignored)
+	///
+	template <typename Ty>
+	static void record(flag_hook hook, Ty const& bits) noexcept;
+	///
+	/// \brief Obtain counts of bit (indexed by flag_hook)
+	///
+	static counts_t counts(std::size_t bit) noexcept;
+	///
+	/// \brief Invoke func(std::size_t bit, counts_t const&) for each bit with a non-zero count
+	///
+	template <typename F>
+	static void for_each(F&& func);
+	///
+	/// \brief Print histogram (one line per used bit) to out
+	///
+	static void dump(std::FILE* out = stdout);
+	///
+	/// \brief Reset all counts to zero
+	///
+	static void clear() noexcept;
+
+  private:
+	inline static std::array<std::array<std::atomic<std::uint64_t>, hooks_v>, bits_v> s_counts{};
+};
+
+// impl
+
+template <typename Enum>
+template <typename Ty>
+void flag_counters<Enum>::record(flag_hook hook, Ty const& bits) noexcept {
+	auto const h = static_cast<std::size_t>(hook);
+	detail::for_each_bit(bits, [h](std::size_t bit) {
+		if (bit < bits_v) { s_counts[bit][h].fetch_add(1, std::memory_order_relaxed); }
+	});
+}
+template <typename Enum>
+typename flag_counters<Enum>::counts_t flag_counters<Enum>::counts(std::size_t bit) noexcept {
+	counts_t ret{};
+	if (bit < bits_v) {
+		for (std::size_t h = 0; h < hooks_v; ++h) { ret[h] = s_counts[bit][h].load(std::memory_order_relaxed); }
+	}
+	return ret;
+}
+template <typename Enum>
+template <typename F>
+void flag_counters<Enum>::for_each(F&& func) {
+	for (std::size_t bit = 0; bit < bits_v; ++bit) {
+		auto const c = counts(bit);
+		for (auto const count : c) {
+			if (count > 0) {
+				func(bit, c);
+				break;
+			}
+		}
+	}
+}
+template <typename Enum>
+void flag_counters<Enum>::dump(std::FILE* out) {
+	std::fprintf(out, "%4s %12s %12s %12s %12s %12s\n", "bit", "set", "reset", "test", "any", "all");
+	for_each([out](std::size_t bit, counts_t const& c) {
+		std::fprintf(out, "%4zu %12llu %12llu %12llu %12llu %12llu\n", bit, static_cast<unsigned long long>(c[0]), static_cast<unsigned long long>(c[1]),
+					 static_cast<unsigned long long>(c[2]), static_cast<unsigned long long>(c[3]), static_cast<unsigned long long>(c[4]));
+	});
+}
+template <typename Enum>
+void flag_counters<Enum>::clear() noexcept {
+	for (auto& bit : s_counts) {
+		for (auto& count : bit) { count.store(0, std::memory_order_relaxed); }
+	}
+}
+} // namespace kt
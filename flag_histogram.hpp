@@ -0,0 +1,215 @@
+// KT header-only library
+// Requirements: C++17, std::thread (for parallel accumulation)
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "bit_utils.hpp"
+
+namespace kt {
+///
+/// \brief Runs task(shard) for each shard in [0, count) on its own std::thread and joins
+/// Link kt::enum-flags-parallel (or a thread library) when using it
+///
+struct thread_executor {
+	template <typename F>
+	void operator()(std::size_t count, F&& task) const;
+};
+
+///
+/// \brief Per-bit set counts over a stream of flags
+/// Bits are counted vertically: a Harley-Seal carry-save adder tree folds each block of 8 values into bit planes,
+/// so the cost per value is a handful of bitwise ops regardless of width; planes are flushed into counters periodically
+///
+template <typename EF>
+class flag_histogram {
+  public:
+	using flags_t = EF;
+	using value_type = typename EF::value_type;
+
+	static_assert(std::is_integral_v<value_type>, "Integral storage required");
+
+	static constexpr std::size_t bits_v = sizeof(value_type) * 8;
+
+	using counts_t = std::array<std::uint64_t, bits_v>;
+
+	///
+	/// \brief Accumulate data[0, count) using shards (0: hardware concurrency) run by executor
+	/// executor(std::size_t shards, F task) must invoke task(shard) for each shard in [0, shards) and return once all are done
+	/// Each shard fills its own histogram; shards are merged after the executor returns (no locks, no shared writes)
+	///
+	template <typename Exec = thread_executor>
+	static flag_histogram parallel(EF const* data, std::size_t count, std::size_t shards = 0, Exec&& executor = {});
+
+	///
+	/// \brief Accumulate one value
+	///
+	void add(EF flags) noexcept;
+	///
+	/// \brief Accumulate data[0, count)
+	///
+	void accumulate(EF const* data, std::size_t count) noexcept;
+	///
+	/// \brief Add counts of rhs into this
+	///
+	flag_histogram& merge(flag_histogram const& rhs) noexcept;
+	void clear() noexcept { *this = {}; }
+
+	///
+	/// \brief Obtain number of accumulated values with bit set
+	///
+	std::uint64_t operator[](std::size_t bit) const noexcept { return bit < bits_v ? counts()[bit] : 0; }
+	///
+	/// \brief Obtain number of accumulated values with (the lowest bit of) flag set
+	///
+	template <typename T>
+	std::uint64_t count(T flag) const noexcept;
+	///
+	/// \brief Obtain per-bit counts
+	///
+	counts_t counts() const noexcept;
+	///
+	/// \brief Obtain number of accumulated values
+	///
+	std::uint64_t total() const noexcept { return m_total; }
+
+  private:
+	using uint_t = std::make_unsigned_t<value_type>;
+
+	static constexpr std::size_t block_v = 8;
+	static constexpr std::size_t planes_v = 16;
+	// blocks whose eights can ripple into the planes before the top plane could overflow
+	static constexpr std::uint32_t flush_blocks_v = (std::uint32_t{1} << planes_v) - 1;
+
+	static constexpr void csa(uint_t& high, uint_t& low, uint_t a, uint_t b, uint_t c) noexcept;
+	static uint_t bits(EF flags) noexcept { return static_cast<uint_t>(static_cast<value_type>(flags)); }
+
+	void add_block(EF const* data) noexcept;
+	void flush() noexcept;
+
+	counts_t m_counts{};
+	std::array<uint_t, planes_v> m_planes{};
+	uint_t m_ones{};
+	uint_t m_twos{};
+	uint_t m_fours{};
+	std::uint32_t m_blocks{};
+	std::uint64_t m_total{};
+};
+
+// impl
+
+template <typename F>
+void thread_executor::operator()(std::size_t count, F&& task) const {
+	std::vector<std::thread> threads;
+	threads.reserve(count);
+	for (std::size_t shard = 0; shard < count; ++shard) {
+		threads.emplace_back([&task, shard]() { task(shard); });
+	}
+	for (auto& thread : threads) { thread.join(); }
+}
+
+template <typename EF>
+constexpr void flag_histogram<EF>::csa(uint_t& high, uint_t& low, uint_t a, uint_t b, uint_t c) noexcept {
+	uint_t const u = a ^ b;
+	high = static_cast<uint_t>((a & b) | (u & c));
+	low = static_cast<uint_t>(u ^ c);
+}
+template <typename EF>
+void flag_histogram<EF>::add(EF flags) noexcept {
+	// ripple into the ones plane; carries are absorbed by twos / fours and flushed before they can be lost
+	uint_t carry = bits(flags);
+	for (uint_t* plane : {&m_ones, &m_twos, &m_fours}) {
+		uint_t const next = *plane & carry;
+		*plane ^= carry;
+		carry = next;
+	}
+	if (carry != 0) {
+		for (std::size_t k = 0; carry != 0 && k < planes_v; ++k) {
+			uint_t const next = m_planes[k] & carry;
+			m_planes[k] ^= carry;
+			carry = next;
+		}
+		if (++m_blocks == flush_blocks_v) { flush(); }
+	}
+	++m_total;
+}
+template <typename EF>
+void flag_histogram<EF>::add_block(EF const* data) noexcept {
+	uint_t twos_a{}, twos_b{}, fours_a{}, fours_b{}, eights{};
+	csa(twos_a, m_ones, m_ones, bits(data[0]), bits(data[1]));
+	csa(twos_b, m_ones, m_ones, bits(data[2]), bits(data[3]));
+	csa(fours_a, m_twos, m_twos, twos_a, twos_b);
+	csa(twos_a, m_ones, m_ones, bits(data[4]), bits(data[5]));
+	csa(twos_b, m_ones, m_ones, bits(data[6]), bits(data[7]));
+	csa(fours_b, m_twos, m_twos, twos_a, twos_b);
+	csa(eights, m_fours, m_fours, fours_a, fours_b);
+	for (std::size_t k = 0; eights != 0 && k < planes_v; ++k) {
+		uint_t const next = m_planes[k] & eights;
+		m_planes[k] ^= eights;
+		eights = next;
+	}
+	if (++m_blocks == flush_blocks_v) { flush(); }
+}
+template <typename EF>
+void flag_histogram<EF>::accumulate(EF const* data, std::size_t count) noexcept {
+	std::size_t i = 0;
+	for (; i + block_v <= count; i += block_v) { add_block(data + i); }
+	m_total += i;
+	for (; i < count; ++i) { add(data[i]); }
+}
+template <typename EF>
+void flag_histogram<EF>::flush() noexcept {
+	m_counts = counts();
+	m_planes = {};
+	m_ones = m_twos = m_fours = {};
+	m_blocks = 0;
+}
+template <typename EF>
+typename flag_histogram<EF>::counts_t flag_histogram<EF>::counts() const noexcept {
+	counts_t ret = m_counts;
+	auto const add_plane = [&ret](uint_t plane, std::uint64_t weight) {
+		detail::for_each_bit(plane, [&ret, weight](std::size_t bit) { ret[bit] += weight; });
+	};
+	add_plane(m_ones, 1);
+	add_plane(m_twos, 2);
+	add_plane(m_fours, 4);
+	for (std::size_t k = 0; k < planes_v; ++k) { add_plane(m_planes[k], std::uint64_t{block_v} << k); }
+	return ret;
+}
+template <typename EF>
+template <typename T>
+std::uint64_t flag_histogram<EF>::count(T flag) const noexcept {
+	return (*this)[detail::countr_zero(static_cast<value_type>(EF::make(flag)))];
+}
+template <typename EF>
+flag_histogram<EF>& flag_histogram<EF>::merge(flag_histogram const& rhs) noexcept {
+	auto const lhs_counts = counts();
+	auto const rhs_counts = rhs.counts();
+	auto const total = m_total + rhs.m_total;
+	clear();
+	for (std::size_t bit = 0; bit < bits_v; ++bit) { m_counts[bit] = lhs_counts[bit] + rhs_counts[bit]; }
+	m_total = total;
+	return *this;
+}
+template <typename EF>
+template <typename Exec>
+flag_histogram<EF> flag_histogram<EF>::parallel(EF const* data, std::size_t count, std::size_t shards, Exec&& executor) {
+	if (shards == 0) { shards = std::thread::hardware_concurrency(); }
+	if (shards == 0) { shards = 1; }
+	// keep shards large enough to amortize startup, and block aligned so only the last one has a tail
+	std::size_t const min_shard = 4096;
+	if (count / shards < min_shard) { shards = count / min_shard > 0 ? count / min_shard : 1; }
+	std::size_t const stride = (count / shards + block_v - 1) / block_v * block_v;
+	std::vector<flag_histogram> results(shards);
+	executor(shards, [&](std::size_t shard) {
+		std::size_t const begin = shard * stride < count ? shard * stride : count;
+		std::size_t const end = shard + 1 == results.size() ? count : (begin + stride < count ? begin + stride : count);
+		results[shard].accumulate(data + begin, end - begin);
+	});
+	flag_histogram ret;
+	for (auto const& result : results) { ret.merge(result); }
+	return ret;
+}
+} // namespace kt
@@ -0,0 +1,197 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "bit_utils.hpp"
+#include "enumerate_enum.hpp"
+#include "flag_query.hpp"
+#include "wide_bits.hpp"
+
+namespace kt {
+namespace detail {
+template <typename EF, typename = void>
+struct flag_bit_count;
+} // namespace detail
+
+///
+/// \brief Column of flags transposed into one plain bitmap per flag bit
+/// Queries (all of / none of) become word-wise ANDs over the relevant bitmaps
+///
+template <typename EF>
+class flag_index {
+  public:
+	using flags_t = EF;
+	using storage_t = typename EF::value_type;
+	using word_t = std::uint64_t;
+	using bitmap_t = std::vector<word_t>;
+
+	///
+	/// \brief Number of bitmaps (enumerate_enum size if Enum::eCOUNT_ exists, else storage width)
+	///
+	static constexpr std::size_t bit_count_v = detail::flag_bit_count<EF>::value;
+	static constexpr std::size_t word_bits_v = sizeof(word_t) * 8;
+
+	///
+	/// \brief Reserve space for rows
+	///
+	void reserve(std::size_t rows);
+	///
+	/// \brief Append a row
+	///
+	void push_back(EF flags);
+	///
+	/// \brief Append count rows
+	///
+	void append(EF const* data, std::size_t count);
+	///
+	/// \brief Remove all rows
+	///
+	void clear() noexcept;
+
+	///
+	/// \brief Obtain number of rows
+	///
+	std::size_t size() const noexcept { return m_size; }
+	///
+	/// \brief Obtain bitmap for bit (one bit per row)
+	///
+	bitmap_t const& bitmap(std::size_t bit) const noexcept { return m_bitmaps[bit]; }
+
+	///
+	/// \brief Write selection bitmap of rows where all bits in all_of and no bits in none_of are set
+	///
+	void match(EF all_of, EF none_of, bitmap_t& out) const;
+	///
+	/// \brief Obtain number of rows where all bits in all_of and no bits in none_of are set
+	///
+	std::size_t count(EF all_of, EF none_of = {}) const;
+	///
+	/// \brief Obtain row IDs where all bits in all_of and no bits in none_of are set
+	///
+	std::vector<std::size_t> select(EF all_of, EF none_of = {}) const;
+	///
+	/// \brief Write selection bitmap of rows matching pred
+	///
+	void match(flag_predicate<EF> const& pred, bitmap_t& out) const;
+	///
+	/// \brief Obtain number of rows matching pred
+	///
+	std::size_t count(flag_predicate<EF> const& pred) const;
+	///
+	/// \brief Obtain row IDs matching pred
+	///
+	std::vector<std::size_t> select(flag_predicate<EF> const& pred) const;
+
+  private:
+	std::array<bitmap_t, bit_count_v> m_bitmaps;
+	std::size_t m_size{};
+};
+
+// impl
+
+namespace detail {
+template <typename EF, typename>
+struct flag_bit_count {
+	using storage_t = typename EF::value_type;
+	static constexpr std::size_t value = [] {
+		if constexpr (is_wide_bits_v<storage_t>) {
+			return storage_t::size_v;
+		} else {
+			return sizeof(storage_t) * 8;
+		}
+	}();
+};
+template <typename EF>
+struct flag_bit_count<EF, std::enable_if_t<EF::is_linear_v && std::is_enum_v<decltype(EF::type::eCOUNT_)>>> {
+	static constexpr std::size_t value = enumerate_enum<typename EF::type>::size();
+};
+} // namespace detail
+
+template <typename EF>
+void flag_index<EF>::reserve(std::size_t rows) {
+	for (auto& bitmap : m_bitmaps) { bitmap.reserve((rows + word_bits_v - 1) / word_bits_v); }
+}
+template <typename EF>
+void flag_index<EF>::push_back(EF flags) {
+	std::size_t const word = m_size / word_bits_v;
+	if (m_size % word_bits_v == 0) {
+		for (auto& bitmap : m_bitmaps) { bitmap.push_back(0); }
+	}
+	word_t const bit = word_t{1} << (m_size % word_bits_v);
+	detail::for_each_bit(static_cast<storage_t>(flags), [&](std::size_t index) {
+		if (index < bit_count_v) { m_bitmaps[index][word] |= bit; }
+	});
+	++m_size;
+}
+template <typename EF>
+void flag_index<EF>::append(EF const* data, std::size_t count) {
+	reserve(m_size + count);
+	for (std::size_t i = 0; i < count; ++i) { push_back(data[i]); }
+}
+template <typename EF>
+void flag_index<EF>::clear() noexcept {
+	for (auto& bitmap : m_bitmaps) { bitmap.clear(); }
+	m_size = 0;
+}
+template <typename EF>
+void flag_index<EF>::match(EF all_of, EF none_of, bitmap_t& out) const {
+	std::size_t const words = (m_size + word_bits_v - 1) / word_bits_v;
+	out.assign(words, ~word_t{});
+	if (m_size % word_bits_v != 0) { out.back() = (word_t{1} << (m_size % word_bits_v)) - 1; }
+	detail::for_each_bit(static_cast<storage_t>(all_of), [&](std::size_t index) {
+		if (index >= bit_count_v) {
+			out.assign(words, 0);
+			return;
+		}
+		auto const& bitmap = m_bitmaps[index];
+		for (std::size_t w = 0; w < words; ++w) { out[w] &= bitmap[w]; }
+	});
+	detail::for_each_bit(static_cast<storage_t>(none_of), [&](std::size_t index) {
+		if (index >= bit_count_v) { return; }
+		auto const& bitmap = m_bitmaps[index];
+		for (std::size_t w = 0; w < words; ++w) { out[w] &= ~bitmap[w]; }
+	});
+}
+template <typename EF>
+void flag_index<EF>::match(flag_predicate<EF> const& pred, bitmap_t& out) const {
+	match(pred.all_of, pred.none_of, out);
+	if (!pred.any_of.any()) { return; }
+	// rows with any bit of any_of: OR of its bitmaps
+	bitmap_t any(out.size(), 0);
+	detail::for_each_bit(static_cast<storage_t>(pred.any_of), [&](std::size_t index) {
+		if (index >= bit_count_v) { return; }
+		auto const& bitmap = m_bitmaps[index];
+		for (std::size_t w = 0; w < any.size(); ++w) { any[w] |= bitmap[w]; }
+	});
+	for (std::size_t w = 0; w < out.size(); ++w) { out[w] &= any[w]; }
+}
+template <typename EF>
+std::size_t flag_index<EF>::count(EF all_of, EF none_of) const {
+	return count(flag_predicate<EF>{all_of, none_of, {}});
+}
+template <typename EF>
+std::vector<std::size_t> flag_index<EF>::select(EF all_of, EF none_of) const {
+	return select(flag_predicate<EF>{all_of, none_of, {}});
+}
+template <typename EF>
+std::size_t flag_index<EF>::count(flag_predicate<EF> const& pred) const {
+	bitmap_t selection;
+	match(pred, selection);
+	std::size_t ret{};
+	for (auto const word : selection) { ret += detail::popcount(word); }
+	return ret;
+}
+template <typename EF>
+std::vector<std::size_t> flag_index<EF>::select(flag_predicate<EF> const& pred) const {
+	bitmap_t selection;
+	match(pred, selection);
+	std::vector<std::size_t> ret;
+	for (std::size_t w = 0; w < selection.size(); ++w) {
+		detail::for_each_bit(selection[w], [&](std::size_t index) { ret.push_back(w * word_bits_v + index); });
+	}
+	return ret;
+}
+} // namespace kt
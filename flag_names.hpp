@@ -0,0 +1,175 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include "bit_utils.hpp"
+
+namespace kt {
+///
+/// \brief Constexpr table of flag names indexed by bit, with a compile-time perfect hash for lookup by name
+///
+template <std::size_t N>
+class flag_names {
+  public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr std::size_t size_v = N;
+
+	///
+	/// \brief Build table; names[i] is the name of bit i (empty names are never found)
+	///
+	constexpr flag_names(std::array<std::string_view, N> const& names) noexcept;
+
+	///
+	/// \brief Obtain name of bit (empty if out of range)
+	///
+	constexpr std::string_view operator[](std::size_t bit) const noexcept { return bit < N ? m_names[bit] : std::string_view(); }
+	///
+	/// \brief Obtain bit for name (npos if not found)
+	///
+	constexpr std::size_t find(std::string_view name) const noexcept;
+
+  private:
+	static constexpr std::size_t slot_count_v = [] {
+		std::size_t ret = 1;
+		while (ret < N * 2) { ret <<= 1; }
+		return ret;
+	}();
+	static constexpr std::size_t max_seeds_v = 256;
+
+	static constexpr std::uint32_t hash(std::string_view str, std::uint32_t seed) noexcept;
+	constexpr bool try_seed(std::uint32_t seed) noexcept;
+
+	std::array<std::string_view, N> m_names{};
+	std::array<std::uint32_t, slot_count_v> m_slots{};
+	std::uint32_t m_seed{};
+};
+
+///
+/// \brief Write names of set bits in flags separated by sep into [first, last)
+/// Returns {one past last written char, errc{}} or {last, errc::value_too_large}
+///
+template <typename EF, std::size_t N>
+constexpr std::to_chars_result to_chars(char* first, char* last, EF flags, flag_names<N> const& names, char sep = '|') noexcept;
+///
+/// \brief Write names of set bits in flags into buf (size n) and null terminate
+/// Returns {terminator, errc{}} or {buf, errc::value_too_large} (buf holds an empty string if n > 0); no flags set writes ""
+///
+template <typename EF, std::size_t N>
+constexpr std::to_chars_result format_flags(EF flags, flag_names<N> const& names, char* buf, std::size_t n, char sep = '|') noexcept;
+///
+/// \brief Parse sep separated names in [first, last) into out
+/// Returns {last, errc{}} or {start of unknown / empty name, errc::invalid_argument}; empty input parses as no flags
+/// Empty names (leading, trailing or doubled separators) are rejected
+///
+template <typename EF, std::size_t N>
+constexpr std::from_chars_result from_chars(char const* first, char const* last, EF& out, flag_names<N> const& names, char sep = '|') noexcept;
+
+// impl
+
+template <std::size_t N>
+constexpr flag_names<N>::flag_names(std::array<std::string_view, N> const& names) noexcept : m_names(names) {
+	for (std::uint32_t seed = 0; seed < max_seeds_v; ++seed) {
+		if (try_seed(seed)) { return; }
+	}
+	// no perfect seed: fall back to linear probing with seed 0
+	m_seed = 0;
+	m_slots = {};
+	for (std::size_t i = 0; i < N; ++i) {
+		if (m_names[i].empty()) { continue; }
+		auto slot = hash(m_names[i], 0) & (slot_count_v - 1);
+		while (m_slots[slot] != 0) { slot = (slot + 1) & (slot_count_v - 1); }
+		m_slots[slot] = static_cast<std::uint32_t>(i + 1);
+	}
+}
+template <std::size_t N>
+constexpr std::size_t flag_names<N>::find(std::string_view name) const noexcept {
+	auto slot = hash(name, m_seed) & (slot_count_v - 1);
+	for (std::size_t probe = 0; probe < slot_count_v && m_slots[slot] != 0; ++probe) {
+		std::size_t const index = m_slots[slot] - 1;
+		if (m_names[index] == name) { return index; }
+		slot = (slot + 1) & (slot_count_v - 1);
+	}
+	return npos;
+}
+template <std::size_t N>
+constexpr std::uint32_t flag_names<N>::hash(std::string_view str, std::uint32_t seed) noexcept {
+	// FNV-1a
+	std::uint32_t ret = 2166136261u ^ (seed * 0x9e3779b9u);
+	for (char const c : str) {
+		ret ^= static_cast<std::uint8_t>(c);
+		ret *= 16777619u;
+	}
+	return ret ^ (ret >> 15);
+}
+template <std::size_t N>
+constexpr bool flag_names<N>::try_seed(std::uint32_t seed) noexcept {
+	m_slots = {};
+	for (std::size_t i = 0; i < N; ++i) {
+		if (m_names[i].empty()) { continue; }
+		auto const slot = hash(m_names[i], seed) & (slot_count_v - 1);
+		if (m_slots[slot] != 0) { return false; }
+		m_slots[slot] = static_cast<std::uint32_t>(i + 1);
+	}
+	m_seed = seed;
+	return true;
+}
+
+template <typename EF, std::size_t N>
+constexpr std::to_chars_result to_chars(char* first, char* last, EF flags, flag_names<N> const& names, char sep) noexcept {
+	using Ty = typename EF::value_type;
+	bool overflow = false;
+	bool separate = false;
+	detail::for_each_bit(static_cast<Ty>(flags), [&](std::size_t index) {
+		if (overflow || index >= N) { return; }
+		auto const name = names[index];
+		auto const length = name.size() + (separate ? 1 : 0);
+		if (static_cast<std::size_t>(last - first) < length) {
+			overflow = true;
+			return;
+		}
+		if (separate) { *first++ = sep; }
+		for (char const c : name) { *first++ = c; }
+		separate = true;
+	});
+	if (overflow) { return {last, std::errc::value_too_large}; }
+	return {first, std::errc{}};
+}
+template <typename EF, std::size_t N>
+constexpr std::to_chars_result format_flags(EF flags, flag_names<N> const& names, char* buf, std::size_t n, char sep) noexcept {
+	if (n == 0) { return {buf, std::errc::value_too_large}; }
+	auto const [ptr, ec] = to_chars(buf, buf + n - 1, flags, names, sep);
+	if (ec != std::errc{}) {
+		*buf = '\0';
+		return {buf, ec};
+	}
+	*ptr = '\0';
+	return {ptr, std::errc{}};
+}
+template <typename EF, std::size_t N>
+constexpr std::from_chars_result from_chars(char const* first, char const* last, EF& out, flag_names<N> const& names, char sep) noexcept {
+	using Ty = typename EF::value_type;
+	Ty bits{};
+	while (first != last) {
+		auto end = first;
+		while (end != last && *end != sep) { ++end; }
+		if (end == first) { return {first, std::errc::invalid_argument}; }
+		auto const index = names.find(std::string_view(first, static_cast<std::size_t>(end - first)));
+		if (index == flag_names<N>::npos) { return {first, std::errc::invalid_argument}; }
+		bits |= detail::bit<Ty>(index);
+		if (end == last) {
+			first = end;
+			break;
+		}
+		first = end + 1;
+		// trailing separator
+		if (first == last) { return {first, std::errc::invalid_argument}; }
+	}
+	out = EF::from_value(bits);
+	return {first, std::errc{}};
+}
+} // namespace kt
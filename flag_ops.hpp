@@ -0,0 +1,121 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <tuple>
+#include <type_traits>
+#include "wide_bits.hpp"
+
+namespace kt {
+///
+/// \brief Kind of a single step in a flag_ops chain
+///
+enum class flag_op_kind { set, reset, flip };
+
+///
+/// \brief Resolved chain of operations on flags type EF: x' = (x & keep) ^ toggle
+///
+template <typename EF>
+struct flag_affine {
+	EF keep;
+	EF toggle;
+
+	constexpr EF operator()(EF x) const noexcept { return (x & keep) ^ toggle; }
+};
+
+///
+/// \brief One step of a flag_ops chain; inputs are resolved through EF::make when applied
+///
+template <flag_op_kind K, typename... T>
+struct flag_op_step {
+	std::tuple<T...> inputs;
+
+	template <typename EF>
+	constexpr void fold(flag_affine<EF>& out) const noexcept;
+};
+
+///
+/// \brief Deferred chain of set / reset / flip steps, applied left to right in one pass
+/// Build with kt::set / kt::reset / kt::flip and compose with |: f.apply(kt::set(a) | kt::reset(b) | kt::flip(c))
+///
+template <typename... Steps>
+struct flag_ops {
+	std::tuple<Steps...> steps;
+
+	///
+	/// \brief Fold all steps into a single keep / toggle pair for EF
+	///
+	template <typename EF>
+	constexpr flag_affine<EF> resolve() const noexcept;
+};
+
+///
+/// \brief Step that sets inputs
+///
+template <typename... T>
+constexpr flag_ops<flag_op_step<flag_op_kind::set, T...>> set(T... t) noexcept {
+	return {{{{t...}}}};
+}
+///
+/// \brief Step that removes inputs
+///
+template <typename... T>
+constexpr flag_ops<flag_op_step<flag_op_kind::reset, T...>> reset(T... t) noexcept {
+	return {{{{t...}}}};
+}
+///
+/// \brief Step that toggles inputs
+///
+template <typename... T>
+constexpr flag_ops<flag_op_step<flag_op_kind::flip, T...>> flip(T... t) noexcept {
+	return {{{{t...}}}};
+}
+
+///
+/// \brief Chain lhs followed by rhs
+///
+template <typename... A, typename... B>
+constexpr flag_ops<A..., B...> operator|(flag_ops<A...> const& lhs, flag_ops<B...> const& rhs) noexcept {
+	return {std::tuple_cat(lhs.steps, rhs.steps)};
+}
+
+// impl
+
+namespace detail {
+template <typename Ty>
+constexpr Ty invert_bits(Ty const& t) noexcept {
+	if constexpr (is_wide_bits_v<Ty>) {
+		return ~t;
+	} else {
+		return static_cast<Ty>(~t);
+	}
+}
+} // namespace detail
+
+template <flag_op_kind K, typename... T>
+template <typename EF>
+constexpr void flag_op_step<K, T...>::fold(flag_affine<EF>& out) const noexcept {
+	using Ty = typename EF::value_type;
+	EF const mask = std::apply([](auto const&... t) { return EF::make(t...); }, inputs);
+	if constexpr (K == flag_op_kind::set) {
+		// ((x & k) ^ t) | m == (x & k & ~m) ^ ((t & ~m) | m)
+		auto const inverse = EF::from_value(detail::invert_bits(static_cast<Ty>(mask)));
+		out.keep = out.keep & inverse;
+		out.toggle = (out.toggle & inverse) | mask;
+	} else if constexpr (K == flag_op_kind::reset) {
+		auto const inverse = EF::from_value(detail::invert_bits(static_cast<Ty>(mask)));
+		out.keep = out.keep & inverse;
+		out.toggle = out.toggle & inverse;
+	} else {
+		out.toggle = out.toggle ^ mask;
+	}
+}
+template <typename... Steps>
+template <typename EF>
+constexpr flag_affine<EF> flag_ops<Steps...>::resolve() const noexcept {
+	using Ty = typename EF::value_type;
+	flag_affine<EF> ret{EF::from_value(detail::invert_bits(Ty{})), EF{}};
+	std::apply([&ret](auto const&... step) { (step.fold(ret), ...); }, steps);
+	return ret;
+}
+} // namespace kt
@@ -0,0 +1,327 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include "flag_codec.hpp"
+#include "flag_histogram.hpp"
+#include "flag_query.hpp"
+
+namespace kt {
+// Stages expose push(T const* data, std::size_t count, Out&& out) and bool finish(Out&& out);
+// out(U const* data, std::size_t count) forwards a chunk downstream. Chunks live in fixed per-stage buffers:
+// nothing is allocated while streaming and each push is forwarded before it returns
+
+///
+/// \brief Decode a byte stream of LEB128 varints (as written by encode_varint) into chunks of EF
+/// A varint split across pushes is carried over to the next push
+///
+template <typename EF, std::size_t Chunk = 256>
+class varint_decode_stage {
+  public:
+	using input_t = std::uint8_t;
+	using output_t = EF;
+
+	template <typename Out>
+	void push(std::uint8_t const* data, std::size_t count, Out&& out);
+	///
+	/// \brief Returns false if the stream was malformed or ended inside a varint
+	///
+	template <typename Out>
+	bool finish(Out&& out);
+
+	bool failed() const noexcept { return m_failed; }
+
+  private:
+	using uint_t = detail::codec_uint_t<EF>;
+
+	template <typename Out>
+	void emit(uint_t value, Out& out);
+
+	std::array<EF, Chunk> m_chunk{};
+	std::size_t m_size{};
+	uint_t m_partial{};
+	std::size_t m_partial_bytes{};
+	bool m_failed{};
+};
+
+///
+/// \brief Decode a byte stream of little-endian raw storage (as written by encode_raw) into chunks of EF
+/// A record split across pushes is carried over to the next push
+///
+template <typename EF, std::size_t Chunk = 256>
+class raw_decode_stage {
+  public:
+	using input_t = std::uint8_t;
+	using output_t = EF;
+
+	template <typename Out>
+	void push(std::uint8_t const* data, std::size_t count, Out&& out);
+	///
+	/// \brief Returns false if the stream ended inside a record
+	///
+	template <typename Out>
+	bool finish(Out&& out);
+
+  private:
+	std::array<EF, Chunk> m_chunk{};
+	std::array<std::uint8_t, raw_size_v<EF>> m_partial{};
+	std::size_t m_partial_bytes{};
+};
+
+///
+/// \brief Map chunks through a flag_remap
+///
+template <typename Remap, std::size_t Chunk = 256>
+class remap_stage {
+  public:
+	using input_t = typename Remap::from_t;
+	using output_t = typename Remap::to_t;
+
+	template <typename Out>
+	void push(input_t const* data, std::size_t count, Out&& out);
+	template <typename Out>
+	bool finish(Out&&) noexcept {
+		return true;
+	}
+
+  private:
+	std::array<output_t, Chunk> m_chunk{};
+};
+
+///
+/// \brief Forward only values matching a flag_predicate
+///
+template <typename EF, std::size_t Chunk = 256>
+class filter_stage {
+  public:
+	using input_t = EF;
+	using output_t = EF;
+
+	constexpr explicit filter_stage(flag_predicate<EF> const& pred) noexcept : m_pred(pred) {}
+
+	template <typename Out>
+	void push(EF const* data, std::size_t count, Out&& out);
+	template <typename Out>
+	bool finish(Out&&) noexcept {
+		return true;
+	}
+
+  private:
+	std::array<EF, Chunk> m_chunk{};
+	flag_predicate<EF> m_pred;
+};
+
+///
+/// \brief Accumulate chunks into a flag_histogram (terminal stage)
+///
+template <typename EF>
+class histogram_sink {
+  public:
+	using input_t = EF;
+
+	constexpr explicit histogram_sink(flag_histogram<EF>& target) noexcept : m_target(&target) {}
+
+	template <typename Out>
+	void push(EF const* data, std::size_t count, Out&&) noexcept {
+		m_target->accumulate(data, count);
+	}
+	template <typename Out>
+	bool finish(Out&&) noexcept {
+		return true;
+	}
+
+  private:
+	flag_histogram<EF>* m_target;
+};
+
+///
+/// \brief Push-based chain of stages: push() feeds the first stage, each stage forwards chunks to the next
+/// Drive it from any I/O loop (read a buffer, push it); call finish() once the input is exhausted
+///
+template <typename... Stages>
+class flag_pipeline {
+  public:
+	static_assert(sizeof...(Stages) > 0, "At least one stage required");
+
+	static constexpr std::size_t size_v = sizeof...(Stages);
+
+	constexpr explicit flag_pipeline(Stages... stages) : m_stages(std::move(stages)...) {}
+
+	///
+	/// \brief Feed data[0, count) into the first stage
+	///
+	template <typename T>
+	void push(T const* data, std::size_t count) {
+		push_stage<0>(data, count);
+	}
+	///
+	/// \brief Flush all stages in order; returns false if any stage reported incomplete / malformed input
+	///
+	bool finish() { return finish_stage<0>(); }
+
+	///
+	/// \brief Obtain stage I
+	///
+	template <std::size_t I>
+	auto& stage() noexcept {
+		return std::get<I>(m_stages);
+	}
+
+  private:
+	template <std::size_t I, typename T>
+	void push_stage(T const* data, std::size_t count);
+	template <std::size_t I>
+	bool finish_stage();
+
+	std::tuple<Stages...> m_stages;
+};
+
+///
+/// \brief Compose stages into a flag_pipeline
+///
+template <typename... Stages>
+constexpr flag_pipeline<Stages...> pipe(Stages... stages) {
+	return flag_pipeline<Stages...>(std::move(stages)...);
+}
+
+// impl
+
+template <typename EF, std::size_t Chunk>
+template <typename Out>
+void varint_decode_stage<EF, Chunk>::emit(uint_t value, Out& out) {
+	m_chunk[m_size++] = EF::from_value(static_cast<typename EF::value_type>(value));
+	if (m_size == Chunk) {
+		out(m_chunk.data(), m_size);
+		m_size = 0;
+	}
+}
+template <typename EF, std::size_t Chunk>
+template <typename Out>
+void varint_decode_stage<EF, Chunk>::push(std::uint8_t const* data, std::size_t count, Out&& out) {
+	constexpr std::size_t max_v = varint_max_size_v<EF>;
+	if (m_failed) { return; }
+	std::size_t i{};
+	// complete a varint split across the previous push
+	while (m_partial_bytes > 0 && i < count) {
+		auto const byte = data[i++];
+		if (!detail::is_valid_varint_byte<uint_t>(byte, m_partial_bytes)) {
+			m_failed = true;
+			return;
+		}
+		m_partial |= static_cast<uint_t>(static_cast<uint_t>(byte & 0x7f) << (7 * m_partial_bytes++));
+		if ((byte & 0x80) == 0) {
+			emit(m_partial, out);
+			m_partial = {};
+			m_partial_bytes = 0;
+		} else if (m_partial_bytes == max_v) {
+			m_failed = true;
+			return;
+		}
+	}
+	while (i < count) {
+		uint_t value{};
+		auto const read = detail::read_varint(data + i, count - i, value);
+		if (read == 0) {
+			if (count - i >= max_v) {
+				m_failed = true;
+				return;
+			}
+			// carry the unterminated tail into the next push (a terminated one was malformed)
+			for (; i < count; ++i) {
+				if ((data[i] & 0x80) == 0) {
+					m_failed = true;
+					return;
+				}
+				m_partial |= static_cast<uint_t>(static_cast<uint_t>(data[i] & 0x7f) << (7 * m_partial_bytes++));
+			}
+			break;
+		}
+		emit(value, out);
+		i += read;
+	}
+	if (m_size > 0) {
+		out(m_chunk.data(), m_size);
+		m_size = 0;
+	}
+}
+template <typename EF, std::size_t Chunk>
+template <typename Out>
+bool varint_decode_stage<EF, Chunk>::finish(Out&&) {
+	return !m_failed && m_partial_bytes == 0;
+}
+
+template <typename EF, std::size_t Chunk>
+template <typename Out>
+void raw_decode_stage<EF, Chunk>::push(std::uint8_t const* data, std::size_t count, Out&& out) {
+	constexpr std::size_t record_v = raw_size_v<EF>;
+	std::size_t i{};
+	// complete a record split across the previous push
+	if (m_partial_bytes > 0) {
+		while (m_partial_bytes < record_v && i < count) { m_partial[m_partial_bytes++] = data[i++]; }
+		if (m_partial_bytes < record_v) { return; }
+		decode_raw(m_partial.data(), record_v, m_chunk[0]);
+		out(m_chunk.data(), std::size_t{1});
+		m_partial_bytes = 0;
+	}
+	while (count - i >= record_v) {
+		std::size_t n = (count - i) / record_v;
+		if (n > Chunk) { n = Chunk; }
+		i += decode_raw(data + i, count - i, m_chunk.data(), n);
+		out(m_chunk.data(), n);
+	}
+	for (; i < count; ++i) { m_partial[m_partial_bytes++] = data[i]; }
+}
+template <typename EF, std::size_t Chunk>
+template <typename Out>
+bool raw_decode_stage<EF, Chunk>::finish(Out&&) {
+	return m_partial_bytes == 0;
+}
+
+template <typename Remap, std::size_t Chunk>
+template <typename Out>
+void remap_stage<Remap, Chunk>::push(input_t const* data, std::size_t count, Out&& out) {
+	for (std::size_t i = 0; i < count; i += Chunk) {
+		std::size_t const n = count - i < Chunk ? count - i : Chunk;
+		Remap::apply(data + i, n, m_chunk.data());
+		out(m_chunk.data(), n);
+	}
+}
+
+template <typename EF, std::size_t Chunk>
+template <typename Out>
+void filter_stage<EF, Chunk>::push(EF const* data, std::size_t count, Out&& out) {
+	std::size_t size{};
+	for (std::size_t i = 0; i < count; ++i) {
+		// branchless compaction: always store, advance only on match
+		m_chunk[size] = data[i];
+		size += static_cast<std::size_t>(m_pred(data[i]));
+		if (size == Chunk) {
+			out(m_chunk.data(), size);
+			size = 0;
+		}
+	}
+	if (size > 0) { out(m_chunk.data(), size); }
+}
+
+template <typename... Stages>
+template <std::size_t I, typename T>
+void flag_pipeline<Stages...>::push_stage(T const* data, std::size_t count) {
+	if constexpr (I < size_v) {
+		std::get<I>(m_stages).push(data, count, [this](auto const* chunk, std::size_t size) { push_stage<I + 1>(chunk, size); });
+	}
+}
+template <typename... Stages>
+template <std::size_t I>
+bool flag_pipeline<Stages...>::finish_stage() {
+	if constexpr (I < size_v) {
+		bool const ret = std::get<I>(m_stages).finish([this](auto const* chunk, std::size_t size) { push_stage<I + 1>(chunk, size); });
+		return finish_stage<I + 1>() && ret;
+	} else {
+		return true;
+	}
+}
+} // namespace kt
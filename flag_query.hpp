@@ -0,0 +1,165 @@
+// KT header-only library
+// Requirements: C++17 (optional: KT_FLAGS_PSTL for parallel algorithms, OpenMP for SIMD)
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "bit_utils.hpp"
+
+#if defined(KT_FLAGS_PSTL) && __has_include(<execution>)
+#include <algorithm>
+#include <execution>
+#include <functional>
+#include <numeric>
+#define KT_FLAGS_DETAIL_PSTL
+#endif
+
+// same definitions as flag_batch.hpp; both headers #undef them at the end
+#if (defined(_OPENMP) || defined(KT_FLAGS_OPENMP_SIMD)) && (!defined(_MSC_VER) || defined(__clang__))
+#define KT_FLAGS_DETAIL_PRAGMA(x) _Pragma(#x)
+#define KT_FLAGS_DETAIL_SIMD(clause) KT_FLAGS_DETAIL_PRAGMA(omp simd clause)
+#else
+#define KT_FLAGS_DETAIL_SIMD(clause)
+#endif
+
+namespace kt {
+///
+/// \brief Conjunction over flag masks: all bits of all_of set, no bits of none_of set, and (if non-empty) any bit of any_of set
+/// Shared by query_count / query_select and flag_index
+///
+template <typename EF>
+struct flag_predicate {
+	EF all_of{};
+	EF none_of{};
+	EF any_of{};
+
+	///
+	/// \brief Require all inputs to be set
+	///
+	template <typename... T>
+	constexpr flag_predicate& all(T... t) noexcept;
+	///
+	/// \brief Require no inputs to be set
+	///
+	template <typename... T>
+	constexpr flag_predicate& none(T... t) noexcept;
+	///
+	/// \brief Require at least one of the (accumulated) any inputs to be set
+	///
+	template <typename... T>
+	constexpr flag_predicate& any(T... t) noexcept;
+
+	///
+	/// \brief Evaluate predicate (branchless)
+	///
+	constexpr bool operator()(EF const& flags) const noexcept;
+};
+
+///
+/// \brief Execution strategy for flag queries
+/// parallel requires KT_FLAGS_PSTL (std::execution::par_unseq), simd requires OpenMP (or KT_FLAGS_OPENMP_SIMD with -fopenmp-simd);
+/// unavailable backends fall back to the scalar loop
+///
+enum class query_backend { scalar, parallel, simd };
+
+///
+/// \brief Obtain number of elements in data[0, count) matching pred
+///
+template <typename EF>
+std::size_t query_count(EF const* data, std::size_t count, flag_predicate<EF> const& pred, query_backend backend = query_backend::scalar);
+///
+/// \brief Write selection bitmap (bit i % 64 of word i / 64 set if data[i] matches pred) into out
+/// Same layout as flag_index bitmaps
+///
+template <typename EF>
+void query_select(EF const* data, std::size_t count, flag_predicate<EF> const& pred, std::vector<std::uint64_t>& out,
+				  query_backend backend = query_backend::scalar);
+
+// impl
+
+template <typename EF>
+template <typename... T>
+constexpr flag_predicate<EF>& flag_predicate<EF>::all(T... t) noexcept {
+	all_of |= EF::make(t...);
+	return *this;
+}
+template <typename EF>
+template <typename... T>
+constexpr flag_predicate<EF>& flag_predicate<EF>::none(T... t) noexcept {
+	none_of |= EF::make(t...);
+	return *this;
+}
+template <typename EF>
+template <typename... T>
+constexpr flag_predicate<EF>& flag_predicate<EF>::any(T... t) noexcept {
+	any_of |= EF::make(t...);
+	return *this;
+}
+template <typename EF>
+constexpr bool flag_predicate<EF>::operator()(EF const& flags) const noexcept {
+	using Ty = typename EF::value_type;
+	auto const bits = static_cast<Ty>(flags);
+	auto const any_bits = static_cast<Ty>(any_of);
+	bool const all_ok = (bits & static_cast<Ty>(all_of)) == static_cast<Ty>(all_of);
+	bool const none_ok = (bits & static_cast<Ty>(none_of)) == Ty{};
+	bool const any_ok = any_bits == Ty{} || (bits & any_bits) != Ty{};
+	return all_ok & none_ok & any_ok;
+}
+
+namespace detail {
+template <typename EF>
+std::size_t query_count_range(EF const* data, std::size_t count, flag_predicate<EF> const& pred, bool simd) noexcept {
+	std::size_t ret{};
+	if (simd) {
+		KT_FLAGS_DETAIL_SIMD(reduction(+ : ret))
+		for (std::size_t i = 0; i < count; ++i) { ret += static_cast<std::size_t>(pred(data[i])); }
+	} else {
+		for (std::size_t i = 0; i < count; ++i) { ret += static_cast<std::size_t>(pred(data[i])); }
+	}
+	return ret;
+}
+template <typename EF>
+std::uint64_t query_word(EF const* data, std::size_t count, flag_predicate<EF> const& pred, std::size_t word, bool simd) noexcept {
+	std::size_t const first = word * 64;
+	std::size_t const n = count - first < 64 ? count - first : 64;
+	std::uint64_t ret{};
+	if (simd) {
+		KT_FLAGS_DETAIL_SIMD(reduction(| : ret))
+		for (std::size_t j = 0; j < n; ++j) { ret |= static_cast<std::uint64_t>(pred(data[first + j])) << j; }
+	} else {
+		for (std::size_t j = 0; j < n; ++j) { ret |= static_cast<std::uint64_t>(pred(data[first + j])) << j; }
+	}
+	return ret;
+}
+} // namespace detail
+
+template <typename EF>
+std::size_t query_count(EF const* data, std::size_t count, flag_predicate<EF> const& pred, query_backend backend) {
+#if defined(KT_FLAGS_DETAIL_PSTL)
+	if (backend == query_backend::parallel) {
+		return std::transform_reduce(std::execution::par_unseq, data, data + count, std::size_t{}, std::plus<>{},
+									 [pred](EF const& flags) { return static_cast<std::size_t>(pred(flags)); });
+	}
+#endif
+	return detail::query_count_range(data, count, pred, backend == query_backend::simd);
+}
+template <typename EF>
+void query_select(EF const* data, std::size_t count, flag_predicate<EF> const& pred, std::vector<std::uint64_t>& out, query_backend backend) {
+	out.assign((count + 63) / 64, 0);
+#if defined(KT_FLAGS_DETAIL_PSTL)
+	if (backend == query_backend::parallel) {
+		// each output word is independent: 64 rows per task
+		std::uint64_t* const words = out.data();
+		std::for_each(std::execution::par_unseq, out.begin(), out.end(), [=](std::uint64_t& word) {
+			word = detail::query_word(data, count, pred, static_cast<std::size_t>(&word - words), false);
+		});
+		return;
+	}
+#endif
+	for (std::size_t w = 0; w < out.size(); ++w) { out[w] = detail::query_word(data, count, pred, w, backend == query_backend::simd); }
+}
+} // namespace kt
+
+#undef KT_FLAGS_DETAIL_SIMD
+#undef KT_FLAGS_DETAIL_PRAGMA
+#undef KT_FLAGS_DETAIL_PSTL
@@ -0,0 +1,225 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <iterator>
+#include <type_traits>
+#include "bit_utils.hpp"
+
+namespace kt {
+template <typename Enum, typename Ty, typename Tr>
+class enum_flags;
+
+namespace detail {
+template <typename Enum, typename Ty, typename Tr>
+struct enum_lut;
+template <typename Enum, typename Tr>
+struct auto_storage;
+
+template <typename EF>
+struct flag_universe;
+} // namespace detail
+
+///
+/// \brief Number of bits kt::combinations draws from by default: the bits used by an enum_flags layout, else the storage width
+///
+template <typename EF>
+inline constexpr std::size_t flag_universe_v = detail::flag_universe<EF>::value;
+
+///
+/// \brief Forward iterator over the set bits of a flags type
+/// Requirements (EF):
+///  - using bit_type = ...
+///  - static bit_type to_bit(std::size_t index) noexcept (accessible)
+///
+template <typename EF>
+struct set_bit_iterator {
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = typename EF::bit_type;
+	using difference_type = std::ptrdiff_t;
+	using pointer = value_type const*;
+	using reference = value_type;
+	using storage_t = typename EF::value_type;
+
+	storage_t bits{};
+
+	constexpr value_type operator*() const noexcept { return EF::to_bit(detail::countr_zero(bits)); }
+	constexpr set_bit_iterator& operator++() noexcept {
+		bits = detail::clear_lowest(bits);
+		return *this;
+	}
+	constexpr set_bit_iterator operator++(int) noexcept {
+		auto ret = *this;
+		++(*this);
+		return ret;
+	}
+
+	friend constexpr bool operator==(set_bit_iterator lhs, set_bit_iterator rhs) noexcept { return lhs.bits == rhs.bits; }
+	friend constexpr bool operator!=(set_bit_iterator lhs, set_bit_iterator rhs) noexcept { return !(lhs == rhs); }
+};
+
+///
+/// \brief Range over the set bits of a flags value; costs one step per set bit
+///
+template <typename EF>
+struct set_bit_range {
+	using value_type = typename EF::bit_type;
+	using const_iterator = set_bit_iterator<EF>;
+
+	typename EF::value_type bits{};
+
+	constexpr const_iterator begin() const noexcept { return const_iterator{bits}; }
+	constexpr const_iterator end() const noexcept { return const_iterator{}; }
+	constexpr bool empty() const noexcept { return begin() == end(); }
+};
+
+///
+/// \brief Forward iterator over flag values produced by a bit-twiddling step function
+/// Requirements (Step):
+///  - static U next(U value, U mask, bool& done) noexcept
+///
+template <typename EF, typename Step>
+struct flag_step_iterator {
+	using storage_t = typename EF::value_type;
+	using uint_t = std::make_unsigned_t<storage_t>;
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = EF;
+	using difference_type = std::ptrdiff_t;
+	using pointer = EF const*;
+	using reference = EF;
+
+	uint_t value{};
+	uint_t mask{};
+	uint_t base{};
+	bool done = true;
+
+	constexpr EF operator*() const noexcept { return EF::from_value(static_cast<storage_t>(base | value)); }
+	constexpr flag_step_iterator& operator++() noexcept {
+		value = Step::next(value, mask, done);
+		if (done) { value = {}; }
+		return *this;
+	}
+	constexpr flag_step_iterator operator++(int) noexcept {
+		auto ret = *this;
+		++(*this);
+		return ret;
+	}
+
+	friend constexpr bool operator==(flag_step_iterator lhs, flag_step_iterator rhs) noexcept {
+		return lhs.done == rhs.done && (lhs.done || lhs.value == rhs.value);
+	}
+	friend constexpr bool operator!=(flag_step_iterator lhs, flag_step_iterator rhs) noexcept { return !(lhs == rhs); }
+};
+
+///
+/// \brief Range over flag values produced by a bit-twiddling step function; one step per output
+///
+template <typename EF, typename Step>
+struct flag_step_range {
+	static_assert(std::is_integral_v<typename EF::value_type>, "Integral storage required");
+
+	using value_type = EF;
+	using const_iterator = flag_step_iterator<EF, Step>;
+
+	const_iterator first{};
+
+	constexpr const_iterator begin() const noexcept { return first; }
+	constexpr const_iterator end() const noexcept { return const_iterator{}; }
+	constexpr bool empty() const noexcept { return first.done; }
+};
+
+namespace detail {
+struct subset_step {
+	// s = (s - 1) & m: descending walk over every subset of m, ending with the empty set
+	template <typename U>
+	static constexpr U next(U value, U mask, bool& done) noexcept {
+		if (value == 0) {
+			done = true;
+			return value;
+		}
+		return static_cast<U>(static_cast<U>(value - 1) & mask);
+	}
+};
+struct superset_step {
+	// t = (t - m) & m: ascending walk over every subset of the free bits m
+	template <typename U>
+	static constexpr U next(U value, U mask, bool& done) noexcept {
+		value = static_cast<U>(static_cast<U>(value - mask) & mask);
+		if (value == 0) { done = true; }
+		return value;
+	}
+};
+struct combination_step {
+	// Gosper's hack: next larger value with the same popcount; mask limits the universe to the lowest n bits
+	template <typename U>
+	static constexpr U next(U value, U mask, bool& done) noexcept {
+		if (value == 0) {
+			done = true;
+			return value;
+		}
+		U const c = static_cast<U>(value & static_cast<U>(~value + 1));
+		U const r = static_cast<U>(value + c);
+		if (r == 0) {
+			done = true;
+			return value;
+		}
+		value = static_cast<U>(static_cast<U>(static_cast<U>((r ^ value) >> 2) / c) | r);
+		if ((value & static_cast<U>(~mask)) != 0) { done = true; }
+		return value;
+	}
+};
+} // namespace detail
+
+///
+/// \brief Range over every subset of a mask (including the mask itself and the empty set)
+///
+template <typename EF>
+using subset_range = flag_step_range<EF, detail::subset_step>;
+///
+/// \brief Range over every superset of a mask within a universe
+///
+template <typename EF>
+using superset_range = flag_step_range<EF, detail::superset_step>;
+///
+/// \brief Range over every k-combination of the lowest n bits
+///
+template <typename EF>
+using combination_range = flag_step_range<EF, detail::combination_step>;
+
+///
+/// \brief Obtain a range over every combination of k bits out of the lowest n bits (flag_universe_v<EF> by default)
+/// Empty if k > n or n > flag_universe_v<EF>
+///
+template <typename EF>
+constexpr combination_range<EF> combinations(std::size_t k, std::size_t n = flag_universe_v<EF>) noexcept;
+
+// impl
+
+namespace detail {
+template <typename EF>
+struct flag_universe {
+	static constexpr std::size_t value = sizeof(typename EF::value_type) * 8;
+};
+template <typename Enum, typename Ty, typename Tr>
+struct flag_universe<enum_flags<Enum, Ty, Tr>> {
+	static constexpr std::size_t value = [] {
+		if constexpr (enum_flags<Enum, Ty, Tr>::is_lut_v) {
+			return enum_lut<Enum, Ty, Tr>::values.size();
+		} else {
+			return auto_storage<Enum, Tr>::bits_v;
+		}
+	}();
+};
+} // namespace detail
+
+template <typename EF>
+constexpr combination_range<EF> combinations(std::size_t k, std::size_t n) noexcept {
+	using U = typename combination_range<EF>::const_iterator::uint_t;
+	constexpr std::size_t width_v = sizeof(U) * 8;
+	static_assert(flag_universe_v<EF> <= width_v, "Enum has more bits than storage");
+	if (n > flag_universe_v<EF> || k > n) { return {}; }
+	U const mask = n == width_v ? static_cast<U>(~U{}) : static_cast<U>((U{1} << n) - 1);
+	U const first = k == width_v ? static_cast<U>(~U{}) : static_cast<U>((U{1} << k) - 1);
+	return {{first, mask, {}, false}};
+}
+} // namespace kt
@@ -0,0 +1,130 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+#include "bit_utils.hpp"
+
+namespace kt {
+///
+/// \brief Maps enumerator From of the source flags to enumerator To of the target flags
+///
+template <auto From, auto To>
+struct remap_pair {};
+
+///
+/// \brief Compile-time mapping of bits between two flag types
+/// Pairs sharing a bit distance fold into a single mask-and-shift; strictly order-preserving maps (no shared sources or targets) use BMI2 pext / pdep when available
+///
+template <typename From, typename To, typename... Pairs>
+struct flag_remap;
+
+template <typename From, typename To, auto... F, auto... T>
+struct flag_remap<From, To, remap_pair<F, T>...> {
+	using from_t = From;
+	using to_t = To;
+	using from_storage_t = typename From::value_type;
+	using to_storage_t = typename To::value_type;
+
+	static_assert(std::is_integral_v<from_storage_t> && std::is_integral_v<to_storage_t>, "Integral storage required");
+	static_assert(sizeof...(F) > 0, "At least one pair required");
+
+	///
+	/// \brief Map set bits of from (unmapped bits are dropped)
+	///
+	static constexpr To apply(From from) noexcept;
+	///
+	/// \brief Map from[0, count) into out[0, count)
+	///
+	static constexpr void apply(From const* from, std::size_t count, To* out) noexcept;
+
+  private:
+	using word_t = std::uint64_t;
+
+	struct group {
+		word_t mask;
+		int shift;
+	};
+
+	static constexpr std::size_t pair_count_v = sizeof...(F);
+	static constexpr std::array<std::size_t, pair_count_v> src_v = {detail::countr_zero(static_cast<from_storage_t>(From(F)))...};
+	static constexpr std::array<std::size_t, pair_count_v> dst_v = {detail::countr_zero(static_cast<to_storage_t>(To(T)))...};
+	static constexpr word_t src_mask_v = (word_t{} | ... | static_cast<word_t>(static_cast<std::make_unsigned_t<from_storage_t>>(From(F))));
+	static constexpr word_t dst_mask_v = (word_t{} | ... | static_cast<word_t>(static_cast<std::make_unsigned_t<to_storage_t>>(To(T))));
+
+	static constexpr std::size_t group_count() noexcept;
+	static constexpr std::array<group, group_count()> make_groups() noexcept;
+	static constexpr bool is_monotonic() noexcept;
+
+	static constexpr std::size_t group_count_v = group_count();
+	static constexpr std::array<group, group_count_v> groups_v = make_groups();
+	static constexpr bool use_pext_v = detail::has_bmi2_v && is_monotonic() && group_count_v > 2;
+
+	template <std::size_t... I>
+	static constexpr word_t apply_groups(word_t from, std::index_sequence<I...>) noexcept;
+};
+
+// impl
+
+template <typename From, typename To, auto... F, auto... T>
+constexpr std::size_t flag_remap<From, To, remap_pair<F, T>...>::group_count() noexcept {
+	std::size_t ret{};
+	for (std::size_t i = 0; i < pair_count_v; ++i) {
+		bool seen = false;
+		for (std::size_t j = 0; j < i; ++j) {
+			if (dst_v[j] - src_v[j] == dst_v[i] - src_v[i]) { seen = true; }
+		}
+		if (!seen) { ++ret; }
+	}
+	return ret;
+}
+template <typename From, typename To, auto... F, auto... T>
+constexpr auto flag_remap<From, To, remap_pair<F, T>...>::make_groups() noexcept -> std::array<group, group_count()> {
+	std::array<group, group_count()> ret{};
+	std::size_t count{};
+	for (std::size_t i = 0; i < pair_count_v; ++i) {
+		int const shift = static_cast<int>(dst_v[i]) - static_cast<int>(src_v[i]);
+		std::size_t g = 0;
+		while (g < count && ret[g].shift != shift) { ++g; }
+		if (g == count) { ret[count++] = {word_t{}, shift}; }
+		ret[g].mask |= word_t{1} << src_v[i];
+	}
+	return ret;
+}
+template <typename From, typename To, auto... F, auto... T>
+constexpr bool flag_remap<From, To, remap_pair<F, T>...>::is_monotonic() noexcept {
+	for (std::size_t i = 0; i < pair_count_v; ++i) {
+		for (std::size_t j = 0; j < pair_count_v; ++j) {
+			if (i != j && src_v[i] <= src_v[j] && dst_v[i] >= dst_v[j]) { return false; }
+		}
+	}
+	return true;
+}
+template <typename From, typename To, auto... F, auto... T>
+template <std::size_t... I>
+constexpr typename flag_remap<From, To, remap_pair<F, T>...>::word_t flag_remap<From, To, remap_pair<F, T>...>::apply_groups(word_t from,
+																											  std::index_sequence<I...>) noexcept {
+	auto const shifted = [from](group const& g) {
+		word_t const bits = from & g.mask;
+		return g.shift >= 0 ? bits << g.shift : bits >> -g.shift;
+	};
+	return (word_t{} | ... | shifted(groups_v[I]));
+}
+template <typename From, typename To, auto... F, auto... T>
+constexpr To flag_remap<From, To, remap_pair<F, T>...>::apply(From from) noexcept {
+	auto const bits = static_cast<word_t>(static_cast<std::make_unsigned_t<from_storage_t>>(static_cast<from_storage_t>(from)));
+	word_t ret{};
+	if constexpr (use_pext_v) {
+		ret = detail::pdep(detail::pext(bits, src_mask_v), dst_mask_v);
+	} else {
+		ret = apply_groups(bits, std::make_index_sequence<group_count_v>());
+	}
+	return To::from_value(static_cast<to_storage_t>(ret));
+}
+template <typename From, typename To, auto... F, auto... T>
+constexpr void flag_remap<From, To, remap_pair<F, T>...>::apply(From const* from, std::size_t count, To* out) noexcept {
+	for (std::size_t i = 0; i < count; ++i) { out[i] = apply(from[i]); }
+}
+} // namespace kt
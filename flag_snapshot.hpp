@@ -0,0 +1,166 @@
+// KT header-only library
+// Requirements: C++17 (C++20 for blocking wait without yielding)
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace kt {
+///
+/// \brief Read-mostly published flags (seqlock)
+/// Readers never write shared memory: single-word flags are one atomic load, wider flags retry while a write is in flight
+/// Writers are serialized through the sequence and are expected to be rare (configuration / toggles)
+///
+template <typename Flags>
+class flag_snapshot {
+  public:
+	using flags_t = Flags;
+	using value_type = typename Flags::value_type;
+
+	static_assert(std::is_trivially_copyable_v<value_type>, "Invalid flags storage");
+
+	flag_snapshot() noexcept : flag_snapshot(Flags{}) {}
+	explicit flag_snapshot(Flags flags) noexcept;
+
+	flag_snapshot(flag_snapshot const&) = delete;
+	flag_snapshot& operator=(flag_snapshot const&) = delete;
+
+	///
+	/// \brief Obtain current flags
+	///
+	Flags load() const noexcept;
+	///
+	/// \brief Obtain number of publishes so far
+	///
+	std::uint32_t version() const noexcept { return m_seq.load(std::memory_order_acquire) / 2; }
+
+	///
+	/// \brief Publish flags
+	///
+	void store(Flags flags) noexcept;
+	///
+	/// \brief Add set bits and remove reset bits in one publish; returns the previous flags
+	///
+	Flags update(Flags set, Flags reset = {}) noexcept;
+
+	///
+	/// \brief Test if any bits in mask differ from previous
+	///
+	bool changed(Flags mask, Flags previous) const noexcept { return ((load() ^ previous) & mask) != Flags{}; }
+	///
+	/// \brief Block until any bits in mask differ from previous; returns the flags observed
+	/// Uses std::atomic::wait when available (no spinning), else yields between polls
+	///
+	Flags wait(Flags mask, Flags previous) const noexcept;
+
+  private:
+	static constexpr std::size_t cache_line_v = 64;
+	static constexpr std::size_t words_v = (sizeof(value_type) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+	using words_t = std::array<std::uint64_t, words_v>;
+
+	std::uint32_t lock() noexcept;
+	void write(Flags flags) noexcept;
+	void unlock(std::uint32_t seq) noexcept;
+	Flags read() const noexcept;
+
+	alignas(cache_line_v) std::atomic<std::uint32_t> m_seq{};
+	std::array<std::atomic<std::uint64_t>, words_v> m_words{};
+};
+
+// impl
+
+template <typename Flags>
+flag_snapshot<Flags>::flag_snapshot(Flags flags) noexcept {
+	write(flags);
+}
+template <typename Flags>
+Flags flag_snapshot<Flags>::read() const noexcept {
+	words_t words{};
+	for (std::size_t i = 0; i < words_v; ++i) { words[i] = m_words[i].load(words_v == 1 ? std::memory_order_acquire : std::memory_order_relaxed); }
+	value_type value{};
+	std::memcpy(static_cast<void*>(&value), words.data(), sizeof(value));
+	return Flags::from_value(value);
+}
+template <typename Flags>
+void flag_snapshot<Flags>::write(Flags flags) noexcept {
+	words_t words{};
+	auto const value = static_cast<value_type>(flags);
+	std::memcpy(words.data(), &value, sizeof(value));
+	for (std::size_t i = 0; i < words_v; ++i) { m_words[i].store(words[i], words_v == 1 ? std::memory_order_release : std::memory_order_relaxed); }
+}
+template <typename Flags>
+Flags flag_snapshot<Flags>::load() const noexcept {
+	// a single word is always consistent
+	if constexpr (words_v == 1) {
+		return read();
+	} else {
+		while (true) {
+			auto const before = m_seq.load(std::memory_order_acquire);
+			if ((before & 1) == 0) {
+				auto const ret = read();
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (m_seq.load(std::memory_order_relaxed) == before) { return ret; }
+			}
+			std::this_thread::yield();
+		}
+	}
+}
+template <typename Flags>
+std::uint32_t flag_snapshot<Flags>::lock() noexcept {
+	// odd sequence: write in flight
+	auto seq = m_seq.load(std::memory_order_relaxed);
+	while ((seq & 1) != 0 || !m_seq.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+		if ((seq & 1) != 0) {
+			std::this_thread::yield();
+			seq = m_seq.load(std::memory_order_relaxed);
+		}
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+	return seq + 1;
+}
+template <typename Flags>
+void flag_snapshot<Flags>::unlock(std::uint32_t seq) noexcept {
+	m_seq.store(seq + 1, std::memory_order_release);
+#if defined(__cpp_lib_atomic_wait)
+	m_seq.notify_all();
+#endif
+}
+template <typename Flags>
+void flag_snapshot<Flags>::store(Flags flags) noexcept {
+	auto const seq = lock();
+	write(flags);
+	unlock(seq);
+}
+template <typename Flags>
+Flags flag_snapshot<Flags>::update(Flags set, Flags reset) noexcept {
+	auto const seq = lock();
+	// writers are exclusive while the sequence is odd
+	auto const ret = read();
+	auto next = ret;
+	next |= set;
+	next &= Flags::from_value(static_cast<value_type>(~static_cast<value_type>(reset)));
+	write(next);
+	unlock(seq);
+	return ret;
+}
+template <typename Flags>
+Flags flag_snapshot<Flags>::wait(Flags mask, Flags previous) const noexcept {
+	while (true) {
+		// sample the sequence first: a publish after this point wakes the wait below
+		auto const seq = m_seq.load(std::memory_order_acquire);
+		auto const ret = load();
+		if (((ret ^ previous) & mask) != Flags{}) { return ret; }
+#if defined(__cpp_lib_atomic_wait)
+		m_seq.wait(seq, std::memory_order_acquire);
+#else
+		(void)seq;
+		std::this_thread::yield();
+#endif
+	}
+}
+} // namespace kt
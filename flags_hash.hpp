@@ -0,0 +1,209 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "enum_flags.hpp"
+#include "uint_flags.hpp"
+
+namespace kt {
+///
+/// \brief Strong 64-bit finalizer (murmur3 fmix64): every input bit affects every output bit
+///
+constexpr std::uint64_t hash_mix(std::uint64_t x) noexcept;
+///
+/// \brief Hash raw flag storage
+///
+template <typename Ty>
+constexpr std::size_t hash_flags(Ty const& bits) noexcept;
+
+///
+/// \brief Open addressing (linear probing) hash map keyed by flags
+/// Requires V to be default constructible; pointers are invalidated on rehash
+///
+template <typename EF, typename V, typename Hash = std::hash<EF>>
+class flags_map {
+  public:
+	using key_type = EF;
+	using mapped_type = V;
+
+	///
+	/// \brief Obtain pointer to value for key (nullptr if absent)
+	///
+	V* find(EF key) noexcept;
+	///
+	/// \brief Obtain pointer to value for key (nullptr if absent)
+	///
+	V const* find(EF key) const noexcept;
+	///
+	/// \brief Test if key is present
+	///
+	bool contains(EF key) const noexcept { return find(key) != nullptr; }
+	///
+	/// \brief Insert value for key if absent; returns {value for key, inserted}
+	///
+	std::pair<V*, bool> insert(EF key, V value);
+	///
+	/// \brief Obtain value for key, inserting a default constructed one if absent
+	///
+	V& operator[](EF key) { return *insert(key, V{}).first; }
+	///
+	/// \brief Remove key; returns true if it was present
+	///
+	bool erase(EF key) noexcept;
+
+	///
+	/// \brief Ensure count entries can be stored without rehashing
+	///
+	void reserve(std::size_t count);
+	void clear() noexcept;
+	std::size_t size() const noexcept { return m_size; }
+	bool empty() const noexcept { return m_size == 0; }
+
+	///
+	/// \brief Invoke func(EF, V&) for each entry
+	///
+	template <typename F>
+	void for_each(F&& func);
+
+  private:
+	static constexpr std::size_t min_capacity_v = 8;
+
+	std::size_t slot(EF key) const noexcept { return Hash{}(key) & (m_keys.size() - 1); }
+	std::size_t probe(EF key) const noexcept;
+	V* place(EF key, V&& value);
+	void rehash(std::size_t capacity);
+
+	std::vector<EF> m_keys;
+	std::vector<V> m_values;
+	std::vector<std::uint8_t> m_used;
+	std::size_t m_size{};
+};
+
+// impl
+
+constexpr std::uint64_t hash_mix(std::uint64_t x) noexcept {
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ull;
+	x ^= x >> 33;
+	return x;
+}
+template <typename Ty>
+constexpr std::size_t hash_flags(Ty const& bits) noexcept {
+	if constexpr (detail::is_wide_bits_v<Ty>) {
+		std::uint64_t ret{};
+		for (auto const word : bits.words) { ret = hash_mix(ret ^ word); }
+		return static_cast<std::size_t>(ret);
+	} else {
+		return static_cast<std::size_t>(hash_mix(static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<Ty>>(bits))));
+	}
+}
+
+template <typename EF, typename V, typename Hash>
+std::size_t flags_map<EF, V, Hash>::probe(EF key) const noexcept {
+	if (m_keys.empty()) { return m_keys.size(); }
+	auto const mask = m_keys.size() - 1;
+	for (auto index = slot(key); m_used[index]; index = (index + 1) & mask) {
+		if (m_keys[index] == key) { return index; }
+	}
+	return m_keys.size();
+}
+template <typename EF, typename V, typename Hash>
+V* flags_map<EF, V, Hash>::find(EF key) noexcept {
+	auto const index = probe(key);
+	return index < m_keys.size() ? &m_values[index] : nullptr;
+}
+template <typename EF, typename V, typename Hash>
+V const* flags_map<EF, V, Hash>::find(EF key) const noexcept {
+	auto const index = probe(key);
+	return index < m_keys.size() ? &m_values[index] : nullptr;
+}
+template <typename EF, typename V, typename Hash>
+std::pair<V*, bool> flags_map<EF, V, Hash>::insert(EF key, V value) {
+	// existing keys never grow the table
+	if (auto const index = probe(key); index < m_keys.size()) { return {&m_values[index], false}; }
+	if ((m_size + 1) * 4 > m_keys.size() * 3) { rehash(m_keys.empty() ? min_capacity_v : m_keys.size() * 2); }
+	return {place(key, std::move(value)), true};
+}
+template <typename EF, typename V, typename Hash>
+V* flags_map<EF, V, Hash>::place(EF key, V&& value) {
+	auto const mask = m_keys.size() - 1;
+	auto index = slot(key);
+	while (m_used[index]) { index = (index + 1) & mask; }
+	m_keys[index] = key;
+	m_values[index] = std::move(value);
+	m_used[index] = 1;
+	++m_size;
+	return &m_values[index];
+}
+template <typename EF, typename V, typename Hash>
+bool flags_map<EF, V, Hash>::erase(EF key) noexcept {
+	auto index = probe(key);
+	if (index == m_keys.size()) { return false; }
+	// backward shift deletion: no tombstones, probe sequences stay short
+	auto const mask = m_keys.size() - 1;
+	for (auto next = (index + 1) & mask; m_used[next]; next = (next + 1) & mask) {
+		auto const home = slot(m_keys[next]);
+		// move next into the hole if its home slot is not within (index, next]
+		if (((next - home) & mask) >= ((next - index) & mask)) {
+			m_keys[index] = m_keys[next];
+			m_values[index] = std::move(m_values[next]);
+			index = next;
+		}
+	}
+	m_used[index] = 0;
+	m_values[index] = V{};
+	--m_size;
+	return true;
+}
+template <typename EF, typename V, typename Hash>
+void flags_map<EF, V, Hash>::reserve(std::size_t count) {
+	std::size_t capacity = min_capacity_v;
+	while (count * 4 > capacity * 3) { capacity <<= 1; }
+	if (capacity > m_keys.size()) { rehash(capacity); }
+}
+template <typename EF, typename V, typename Hash>
+void flags_map<EF, V, Hash>::clear() noexcept {
+	m_keys.clear();
+	m_values.clear();
+	m_used.clear();
+	m_size = 0;
+}
+template <typename EF, typename V, typename Hash>
+template <typename F>
+void flags_map<EF, V, Hash>::for_each(F&& func) {
+	for (std::size_t i = 0; i < m_keys.size(); ++i) {
+		if (m_used[i]) { func(m_keys[i], m_values[i]); }
+	}
+}
+template <typename EF, typename V, typename Hash>
+void flags_map<EF, V, Hash>::rehash(std::size_t capacity) {
+	auto keys = std::move(m_keys);
+	auto values = std::move(m_values);
+	auto used = std::move(m_used);
+	m_keys.assign(capacity, EF{});
+	m_values.clear();
+	m_values.resize(capacity);
+	m_used.assign(capacity, 0);
+	m_size = 0;
+	for (std::size_t i = 0; i < keys.size(); ++i) {
+		if (used[i]) { place(keys[i], std::move(values[i])); }
+	}
+}
+} // namespace kt
+
+namespace std {
+template <typename Enum, typename Ty, typename Tr>
+struct hash<kt::enum_flags<Enum, Ty, Tr>> {
+	constexpr size_t operator()(kt::enum_flags<Enum, Ty, Tr> const& flags) const noexcept { return kt::hash_flags(static_cast<Ty>(flags)); }
+};
+template <typename Ty>
+struct hash<kt::uint_flags<Ty>> {
+	constexpr size_t operator()(kt::uint_flags<Ty> const& flags) const noexcept { return kt::hash_flags(static_cast<Ty>(flags)); }
+};
+} // namespace std
@@ -0,0 +1,85 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include "bit_utils.hpp"
+
+namespace kt {
+///
+/// \brief Dense lookup table with one slot per possible value of a (at most 16-bit) flags type
+///
+template <typename EF, typename V>
+class flags_table {
+  public:
+	using storage_t = typename EF::value_type;
+
+	static_assert(std::is_integral_v<storage_t> && sizeof(storage_t) <= 2, "Storage must be integral and at most 16 bits");
+
+	static constexpr std::size_t size_v = std::size_t{1} << (sizeof(storage_t) * 8);
+
+	///
+	/// \brief Build table by invoking gen(EF) -> V for every mask (constexpr if gen is)
+	///
+	template <typename F>
+	static constexpr flags_table generate(F&& gen);
+
+	constexpr V const& operator[](EF flags) const noexcept { return m_values[index(flags)]; }
+	constexpr V& operator[](EF flags) noexcept { return m_values[index(flags)]; }
+
+  private:
+	static constexpr std::size_t index(EF flags) noexcept { return static_cast<std::make_unsigned_t<storage_t>>(static_cast<storage_t>(flags)); }
+
+	std::array<V, size_v> m_values{};
+};
+
+///
+/// \brief Dense lookup table keyed only by the bits of a flags type selected by Mask
+/// Bits outside Mask are ignored; selected bits are packed into an index via pext
+///
+template <typename EF, typename V, typename EF::value_type Mask>
+class sparse_flags_table {
+  public:
+	using storage_t = typename EF::value_type;
+
+	static_assert(std::is_integral_v<storage_t>, "Storage must be integral");
+	static_assert(detail::popcount(Mask) <= 16, "Mask must select at most 16 bits");
+
+	static constexpr std::size_t size_v = std::size_t{1} << detail::popcount(Mask);
+
+	///
+	/// \brief Build table by invoking gen(EF) -> V for every combination of bits in Mask (constexpr if gen is)
+	///
+	template <typename F>
+	static constexpr sparse_flags_table generate(F&& gen);
+
+	constexpr V const& operator[](EF flags) const noexcept { return m_values[index(flags)]; }
+	constexpr V& operator[](EF flags) noexcept { return m_values[index(flags)]; }
+
+  private:
+	static constexpr std::size_t index(EF flags) noexcept {
+		return static_cast<std::size_t>(static_cast<std::make_unsigned_t<storage_t>>(detail::pext(static_cast<storage_t>(flags), Mask)));
+	}
+
+	std::array<V, size_v> m_values{};
+};
+
+// impl
+
+template <typename EF, typename V>
+template <typename F>
+constexpr flags_table<EF, V> flags_table<EF, V>::generate(F&& gen) {
+	flags_table ret;
+	for (std::size_t i = 0; i < size_v; ++i) { ret.m_values[i] = gen(EF::from_value(static_cast<storage_t>(i))); }
+	return ret;
+}
+template <typename EF, typename V, typename EF::value_type Mask>
+template <typename F>
+constexpr sparse_flags_table<EF, V, Mask> sparse_flags_table<EF, V, Mask>::generate(F&& gen) {
+	sparse_flags_table ret;
+	for (std::size_t i = 0; i < size_v; ++i) { ret.m_values[i] = gen(EF::from_value(detail::pdep(static_cast<storage_t>(i), Mask))); }
+	return ret;
+}
+} // namespace kt
@@ -0,0 +1,274 @@
+// KT header-only library
+// Requirements: C++17, POSIX (for file mapping)
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include "enum_flags.hpp"
+#include "enum_reflect.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define KT_FLAGS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kt {
+///
+/// \brief On-disk header preceding a flag column (stored in native byte order)
+///
+struct flag_column_header {
+	static constexpr std::uint32_t magic_v = 0x4346544b; // "KTFC"
+	static constexpr std::uint16_t version_v = 2;
+	static constexpr std::uint32_t endian_v = 0x01020304;
+	static constexpr std::uint64_t data_offset_v = 64;
+
+	std::uint32_t magic;
+	std::uint16_t version;
+	std::uint8_t width;
+	std::uint8_t trait;
+	std::uint32_t endian;
+	std::uint32_t enum_count;
+	std::uint64_t layout_hash;
+	std::uint64_t rows;
+	std::uint64_t data_offset;
+};
+
+///
+/// \brief Layout version of Enum mixed into mapped_flag_column's layout hash: specialize and bump when the meaning of a bit changes without a rename
+///
+template <typename Enum>
+struct flag_column_version : std::integral_constant<std::uint32_t, 0> {};
+
+///
+/// \brief Read-only or copy-on-write view of a persisted column of enum_flags
+/// Opening validates the header (width, trait, endianness, enumerator layout) against this type; startup is O(1)
+/// The layout hash covers the value and reflected name of each bit's enumerator (see enum_reflect) and flag_column_version<Enum>:
+/// reordering or renaming enumerators is detected, changing what an enumerator means is not unless the version is bumped
+///
+template <typename Enum, typename Ty = std::uint32_t, typename Tr = enum_trait_linear>
+class mapped_flag_column {
+  public:
+	using flags_t = enum_flags<Enum, Ty, Tr>;
+	using const_iterator = flags_t const*;
+
+	static_assert(std::is_integral_v<Ty>, "Ty must be integral");
+	static_assert(sizeof(flags_t) == sizeof(Ty) && std::is_trivially_copyable_v<flags_t>, "Invalid flags layout");
+	static_assert(sizeof(flag_column_header) <= flag_column_header::data_offset_v, "Invalid header size");
+
+	enum class mode { read_only, copy_on_write };
+
+	///
+	/// \brief Build header for a column of rows
+	///
+	static constexpr flag_column_header make_header(std::uint64_t rows) noexcept;
+	///
+	/// \brief Test if header describes a column readable as this type
+	///
+	static constexpr bool is_compatible(flag_column_header const& header) noexcept;
+	///
+	/// \brief Write header and data[0, count) to path
+	///
+	static bool write(char const* path, flags_t const* data, std::size_t count);
+	///
+	/// \brief Obtain a non-owning view over an in-memory image (header + data); empty if invalid
+	///
+	static mapped_flag_column view(void const* image, std::size_t size) noexcept;
+
+	mapped_flag_column() = default;
+	mapped_flag_column(mapped_flag_column&& rhs) noexcept { swap(rhs); }
+	mapped_flag_column& operator=(mapped_flag_column rhs) noexcept { return (swap(rhs), *this); }
+	~mapped_flag_column() { close(); }
+
+	///
+	/// \brief Map path into memory (requires POSIX); returns false if unavailable / invalid
+	///
+	bool open(char const* path, mode m = mode::read_only);
+	///
+	/// \brief Unmap if owning and reset to empty
+	///
+	void close() noexcept;
+
+	explicit operator bool() const noexcept { return m_data != nullptr; }
+	std::size_t size() const noexcept { return m_size; }
+	bool empty() const noexcept { return m_size == 0; }
+	flags_t const* data() const noexcept { return m_data; }
+	///
+	/// \brief Obtain writable data (copy_on_write mappings only; nullptr otherwise)
+	///
+	flags_t* mutable_data() noexcept { return m_writable ? const_cast<flags_t*>(m_data) : nullptr; }
+	flags_t operator[](std::size_t index) const noexcept { return m_data[index]; }
+	const_iterator begin() const noexcept { return m_data; }
+	const_iterator end() const noexcept { return m_data + m_size; }
+
+  private:
+	static constexpr std::uint8_t trait_id() noexcept;
+	static constexpr std::uint32_t enum_count() noexcept;
+	static constexpr std::uint64_t layout_hash() noexcept;
+	static flags_t const* validate(void const* image, std::size_t size, std::size_t& out_rows) noexcept;
+
+	void swap(mapped_flag_column& rhs) noexcept;
+
+	flags_t const* m_data{};
+	std::size_t m_size{};
+	void* m_map{};
+	std::size_t m_map_size{};
+	bool m_writable{};
+};
+
+// impl
+
+template <typename Enum, typename Ty, typename Tr>
+constexpr std::uint8_t mapped_flag_column<Enum, Ty, Tr>::trait_id() noexcept {
+	if constexpr (flags_t::is_linear_v) {
+		return 0;
+	} else if constexpr (flags_t::is_lut_v) {
+		return 2;
+	} else {
+		return 1;
+	}
+}
+template <typename Enum, typename Ty, typename Tr>
+constexpr std::uint32_t mapped_flag_column<Enum, Ty, Tr>::enum_count() noexcept {
+	if constexpr (flags_t::is_lut_v) {
+		return static_cast<std::uint32_t>(detail::enum_lut<Enum, Ty, Tr>::values.size());
+	} else {
+		return static_cast<std::uint32_t>(detail::auto_storage<Enum, Tr>::bits_v);
+	}
+}
+template <typename Enum, typename Ty, typename Tr>
+constexpr std::uint64_t mapped_flag_column<Enum, Ty, Tr>::layout_hash() noexcept {
+	// FNV-1a over the storage width, trait, layout version and the underlying value and name of each bit's enumerator
+	using reflect_t = enum_reflect<Enum, std::conditional_t<std::is_same_v<Tr, enum_trait_pot>, enum_trait_pot, enum_trait_linear>>;
+	std::uint64_t ret = 14695981039346656037ull;
+	auto const mix_byte = [&ret](std::uint64_t byte) {
+		ret ^= byte & 0xff;
+		ret *= 1099511628211ull;
+	};
+	auto const mix = [&mix_byte](std::uint64_t value) {
+		for (int i = 0; i < 8; ++i) { mix_byte(value >> (i * 8)); }
+	};
+	mix(sizeof(Ty));
+	mix(trait_id());
+	mix(flag_column_version<Enum>::value);
+	for (std::size_t i = 0; i < enum_count() && i < sizeof(Ty) * 8; ++i) {
+		auto const e = *flags_t::from_value(detail::bit<Ty>(i)).set_bits().begin();
+		mix(static_cast<std::uint64_t>(e));
+		auto const name = reflect_t::name(e);
+		mix(name.size());
+		for (char const c : name) { mix_byte(static_cast<unsigned char>(c)); }
+	}
+	return ret;
+}
+template <typename Enum, typename Ty, typename Tr>
+constexpr flag_column_header mapped_flag_column<Enum, Ty, Tr>::make_header(std::uint64_t rows) noexcept {
+	flag_column_header ret{};
+	ret.magic = flag_column_header::magic_v;
+	ret.version = flag_column_header::version_v;
+	ret.width = static_cast<std::uint8_t>(sizeof(Ty));
+	ret.trait = trait_id();
+	ret.endian = flag_column_header::endian_v;
+	ret.enum_count = enum_count();
+	ret.layout_hash = layout_hash();
+	ret.rows = rows;
+	ret.data_offset = flag_column_header::data_offset_v;
+	return ret;
+}
+template <typename Enum, typename Ty, typename Tr>
+constexpr bool mapped_flag_column<Enum, Ty, Tr>::is_compatible(flag_column_header const& header) noexcept {
+	auto const expected = make_header(header.rows);
+	return header.magic == expected.magic && header.version == expected.version && header.width == expected.width && header.trait == expected.trait &&
+		   header.endian == expected.endian && header.enum_count == expected.enum_count && header.layout_hash == expected.layout_hash &&
+		   header.data_offset >= sizeof(flag_column_header) && header.data_offset % alignof(Ty) == 0;
+}
+template <typename Enum, typename Ty, typename Tr>
+bool mapped_flag_column<Enum, Ty, Tr>::write(char const* path, flags_t const* data, std::size_t count) {
+	std::FILE* file = std::fopen(path, "wb");
+	if (!file) { return false; }
+	char image[flag_column_header::data_offset_v]{};
+	auto const header = make_header(count);
+	std::memcpy(image, &header, sizeof(header));
+	bool ret = std::fwrite(image, sizeof(image), 1, file) == 1;
+	if (ret && count > 0) { ret = std::fwrite(data, sizeof(flags_t), count, file) == count; }
+	return std::fclose(file) == 0 && ret;
+}
+template <typename Enum, typename Ty, typename Tr>
+typename mapped_flag_column<Enum, Ty, Tr>::flags_t const* mapped_flag_column<Enum, Ty, Tr>::validate(void const* image, std::size_t size,
+																									 std::size_t& out_rows) noexcept {
+	if (!image || size < sizeof(flag_column_header)) { return nullptr; }
+	flag_column_header header;
+	std::memcpy(&header, image, sizeof(header));
+	if (!is_compatible(header) || header.data_offset > size) { return nullptr; }
+	if ((size - header.data_offset) / sizeof(Ty) < header.rows) { return nullptr; }
+	auto const* bytes = static_cast<unsigned char const*>(image) + header.data_offset;
+	if (reinterpret_cast<std::uintptr_t>(bytes) % alignof(flags_t) != 0) { return nullptr; }
+	out_rows = static_cast<std::size_t>(header.rows);
+	return reinterpret_cast<flags_t const*>(bytes);
+}
+template <typename Enum, typename Ty, typename Tr>
+mapped_flag_column<Enum, Ty, Tr> mapped_flag_column<Enum, Ty, Tr>::view(void const* image, std::size_t size) noexcept {
+	mapped_flag_column ret;
+	ret.m_data = validate(image, size, ret.m_size);
+	if (!ret.m_data) { ret.m_size = 0; }
+	return ret;
+}
+template <typename Enum, typename Ty, typename Tr>
+bool mapped_flag_column<Enum, Ty, Tr>::open(char const* path, mode m) {
+	close();
+#if defined(KT_FLAGS_MMAP)
+	int const fd = ::open(path, O_RDONLY);
+	if (fd < 0) { return false; }
+	struct stat st {};
+	if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+	auto const size = static_cast<std::size_t>(st.st_size);
+	int const prot = m == mode::copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ;
+	void* map = ::mmap(nullptr, size, prot, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED) { return false; }
+	std::size_t rows{};
+	auto const* data = validate(map, size, rows);
+	if (!data) {
+		::munmap(map, size);
+		return false;
+	}
+	m_data = data;
+	m_size = rows;
+	m_map = map;
+	m_map_size = size;
+	m_writable = m == mode::copy_on_write;
+	return true;
+#else
+	(void)path;
+	(void)m;
+	return false;
+#endif
+}
+template <typename Enum, typename Ty, typename Tr>
+void mapped_flag_column<Enum, Ty, Tr>::close() noexcept {
+#if defined(KT_FLAGS_MMAP)
+	if (m_map) { ::munmap(m_map, m_map_size); }
+#endif
+	m_data = nullptr;
+	m_size = 0;
+	m_map = nullptr;
+	m_map_size = 0;
+	m_writable = false;
+}
+template <typename Enum, typename Ty, typename Tr>
+void mapped_flag_column<Enum, Ty, Tr>::swap(mapped_flag_column& rhs) noexcept {
+	std::swap(m_data, rhs.m_data);
+	std::swap(m_size, rhs.m_size);
+	std::swap(m_map, rhs.m_map);
+	std::swap(m_map_size, rhs.m_map_size);
+	std::swap(m_writable, rhs.m_writable);
+}
+} // namespace kt
+
+#undef KT_FLAGS_MMAP
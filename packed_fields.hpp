@@ -0,0 +1,267 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <tuple>
+#include "enum_flags.hpp"
+#include "uint_flags.hpp"
+
+namespace kt {
+///
+/// \brief Field of packed_fields holding a T (enum, integral or bool) in Bits bits
+/// Signed integral values are sign extended on read; enums are not (a default scoped enum's int underlying type would read a set top bit as negative)
+///
+template <typename T, std::size_t Bits>
+struct bit_field {
+	static_assert(std::is_enum_v<T> || std::is_integral_v<T>, "T must be an enum or integral");
+	static_assert(Bits > 0, "Bits must be positive");
+
+	using value_type = T;
+	static constexpr std::size_t bits_v = Bits;
+};
+
+///
+/// \brief Field of packed_fields holding enum_flags of Enum (one bit per enumerator, as enum_flags lays them out)
+///
+template <typename Enum, typename Tr = enum_trait_linear, std::size_t Bits = detail::auto_storage<Enum, Tr>::bits_v>
+struct flags_field {
+	static_assert(Bits > 0, "Bits must be positive");
+
+	using enum_type = Enum;
+	using trait_type = Tr;
+	static constexpr std::size_t bits_v = Bits;
+};
+
+template <typename Packed, std::size_t I>
+class packed_flags_ref;
+
+///
+/// \brief Several fields packed into one unsigned Ty, offsets assigned at compile time in declaration order (from bit 0)
+/// Each get / set is a single mask-and-shift; trivial and union friendly like uint_flags
+/// flags<I>() combines a flags_field in place (set / reset / flip / update, |= / &= / ^=) without copying it out
+///
+template <typename Ty, typename... Fields>
+struct packed_fields {
+	static_assert(std::is_unsigned_v<Ty>, "Ty must be unsigned");
+	static_assert(sizeof...(Fields) > 0, "At least one field required");
+
+	using storage_t = uint_flags<Ty>;
+	template <std::size_t I>
+	using field_t = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+	static constexpr std::size_t size_v = sizeof...(Fields);
+	static constexpr std::size_t bits_v = (Fields::bits_v + ...);
+
+	static_assert(bits_v <= sizeof(Ty) * 8, "Fields do not fit in Ty");
+
+	///
+	/// \brief Obtain offset of field I
+	///
+	template <std::size_t I>
+	static constexpr std::size_t offset() noexcept;
+	///
+	/// \brief Obtain in-place mask of field I
+	///
+	template <std::size_t I>
+	static constexpr Ty mask() noexcept;
+
+  private:
+	template <typename F>
+	struct value_of {
+		using type = typename F::value_type;
+	};
+	template <typename Enum, typename Tr, std::size_t Bits>
+	struct value_of<flags_field<Enum, Tr, Bits>> {
+		using type = enum_flags<Enum, Ty, Tr>;
+	};
+
+  public:
+	template <std::size_t I>
+	using value_t = typename value_of<field_t<I>>::type;
+
+	///
+	/// \brief Trivial storage (default initialized)
+	///
+	storage_t bits;
+
+	///
+	/// \brief Obtain value of field I (a copy for flags_field: see flags())
+	///
+	template <std::size_t I>
+	constexpr value_t<I> get() const noexcept;
+	///
+	/// \brief Obtain a reference to flags_field I whose set / reset / flip / update write in place with one mask-and-shift
+	///
+	template <std::size_t I>
+	constexpr packed_flags_ref<packed_fields, I> flags() noexcept {
+		return packed_flags_ref<packed_fields, I>(*this);
+	}
+	///
+	/// \brief Replace value of field I (excess bits are dropped)
+	///
+	template <std::size_t I>
+	constexpr packed_fields& set(value_t<I> value) noexcept;
+};
+
+///
+/// \brief Reference to flags_field I of a packed_fields: reads through get<I>(), writes only the field's bits in place
+///
+template <typename Packed, std::size_t I>
+class packed_flags_ref {
+  public:
+	using flags_t = typename Packed::template value_t<I>;
+	using storage_t = typename flags_t::value_type;
+
+	static_assert(std::is_same_v<flags_t, enum_flags<typename flags_t::type, storage_t, typename Packed::template field_t<I>::trait_type>>,
+				  "Field must be a flags_field");
+
+	constexpr explicit packed_flags_ref(Packed& packed) noexcept : m_packed(&packed) {}
+
+	constexpr flags_t get() const noexcept { return m_packed->template get<I>(); }
+	constexpr operator flags_t() const noexcept { return get(); }
+	///
+	/// \brief Replace the field
+	///
+	constexpr packed_flags_ref& operator=(flags_t flags) noexcept;
+	///
+	/// \brief Replace the field with the value referenced by rhs (does not rebind)
+	///
+	constexpr packed_flags_ref& operator=(packed_flags_ref const& rhs) noexcept { return *this = rhs.get(); }
+	constexpr packed_flags_ref(packed_flags_ref const&) = default;
+
+	template <typename... T>
+	constexpr packed_flags_ref& set(T... t) noexcept;
+	template <typename... T>
+	constexpr packed_flags_ref& reset(T... t) noexcept;
+	template <typename... T>
+	constexpr packed_flags_ref& flip(T... t) noexcept;
+	constexpr packed_flags_ref& update(flags_t set, flags_t reset = {}) noexcept;
+
+	constexpr packed_flags_ref& operator|=(flags_t flags) noexcept { return set(flags); }
+	constexpr packed_flags_ref& operator&=(flags_t flags) noexcept;
+	constexpr packed_flags_ref& operator^=(flags_t flags) noexcept { return flip(flags); }
+
+	template <typename T>
+	constexpr bool test(T t) const noexcept {
+		return get().test(t);
+	}
+	template <typename... T>
+	constexpr bool any(T... t) const noexcept {
+		return get().any(t...);
+	}
+	template <typename... T>
+	constexpr bool all(T... t) const noexcept {
+		return get().all(t...);
+	}
+	constexpr std::size_t count() const noexcept { return get().count(); }
+
+  private:
+	// flags moved to the field's offset
+	static constexpr storage_t shifted(flags_t flags) noexcept;
+	constexpr void write(storage_t bits) noexcept { m_packed->bits = decltype(m_packed->bits)::from_value(bits); }
+
+	Packed* m_packed;
+};
+
+// impl
+
+namespace detail {
+template <typename T, bool = std::is_enum_v<T>>
+struct underlying_or_self {
+	using type = T;
+};
+template <typename T>
+struct underlying_or_self<T, true> {
+	using type = std::underlying_type_t<T>;
+};
+} // namespace detail
+
+template <typename Ty, typename... Fields>
+template <std::size_t I>
+constexpr std::size_t packed_fields<Ty, Fields...>::offset() noexcept {
+	constexpr std::size_t widths[] = {Fields::bits_v...};
+	std::size_t ret{};
+	for (std::size_t i = 0; i < I; ++i) { ret += widths[i]; }
+	return ret;
+}
+template <typename Ty, typename... Fields>
+template <std::size_t I>
+constexpr Ty packed_fields<Ty, Fields...>::mask() noexcept {
+	constexpr std::size_t width_v = field_t<I>::bits_v;
+	constexpr Ty low_v = width_v == sizeof(Ty) * 8 ? static_cast<Ty>(~Ty{}) : static_cast<Ty>((Ty{1} << width_v) - 1);
+	return static_cast<Ty>(low_v << offset<I>());
+}
+template <typename Ty, typename... Fields>
+template <std::size_t I>
+constexpr typename packed_fields<Ty, Fields...>::template value_t<I> packed_fields<Ty, Fields...>::get() const noexcept {
+	using T = value_t<I>;
+	auto const raw = static_cast<Ty>((bits.bits & mask<I>()) >> offset<I>());
+	if constexpr (std::is_same_v<T, bool>) {
+		return raw != 0;
+	} else if constexpr (std::is_enum_v<T> || std::is_integral_v<T>) {
+		using U = typename detail::underlying_or_self<T>::type;
+		constexpr std::size_t width_v = field_t<I>::bits_v;
+		if constexpr (std::is_integral_v<T> && std::is_signed_v<U> && width_v < sizeof(Ty) * 8) {
+			// sign extend from the top bit of the field
+			constexpr Ty sign_v = static_cast<Ty>(Ty{1} << (width_v - 1));
+			return static_cast<T>(static_cast<U>(static_cast<std::make_signed_t<Ty>>(static_cast<Ty>((raw ^ sign_v) - sign_v))));
+		} else {
+			return static_cast<T>(static_cast<U>(raw));
+		}
+	} else {
+		return T::from_value(raw);
+	}
+}
+template <typename Ty, typename... Fields>
+template <std::size_t I>
+constexpr packed_fields<Ty, Fields...>& packed_fields<Ty, Fields...>::set(value_t<I> value) noexcept {
+	using T = value_t<I>;
+	Ty raw{};
+	if constexpr (std::is_enum_v<T>) {
+		raw = static_cast<Ty>(static_cast<std::underlying_type_t<T>>(value));
+	} else {
+		raw = static_cast<Ty>(value);
+	}
+	bits = storage_t::from_value(static_cast<Ty>((bits.bits & static_cast<Ty>(~mask<I>())) | (static_cast<Ty>(raw << offset<I>()) & mask<I>())));
+	return *this;
+}
+
+template <typename Packed, std::size_t I>
+constexpr typename packed_flags_ref<Packed, I>::storage_t packed_flags_ref<Packed, I>::shifted(flags_t flags) noexcept {
+	return static_cast<storage_t>(static_cast<storage_t>(static_cast<storage_t>(flags) << Packed::template offset<I>()) & Packed::template mask<I>());
+}
+template <typename Packed, std::size_t I>
+constexpr packed_flags_ref<Packed, I>& packed_flags_ref<Packed, I>::operator=(flags_t flags) noexcept {
+	m_packed->template set<I>(flags);
+	return *this;
+}
+template <typename Packed, std::size_t I>
+template <typename... T>
+constexpr packed_flags_ref<Packed, I>& packed_flags_ref<Packed, I>::set(T... t) noexcept {
+	write(static_cast<storage_t>(m_packed->bits.bits | shifted(flags_t::make(t...))));
+	return *this;
+}
+template <typename Packed, std::size_t I>
+template <typename... T>
+constexpr packed_flags_ref<Packed, I>& packed_flags_ref<Packed, I>::reset(T... t) noexcept {
+	write(static_cast<storage_t>(m_packed->bits.bits & static_cast<storage_t>(~shifted(flags_t::make(t...)))));
+	return *this;
+}
+template <typename Packed, std::size_t I>
+template <typename... T>
+constexpr packed_flags_ref<Packed, I>& packed_flags_ref<Packed, I>::flip(T... t) noexcept {
+	write(static_cast<storage_t>(m_packed->bits.bits ^ shifted(flags_t::make(t...))));
+	return *this;
+}
+template <typename Packed, std::size_t I>
+constexpr packed_flags_ref<Packed, I>& packed_flags_ref<Packed, I>::update(flags_t set, flags_t reset) noexcept {
+	write(static_cast<storage_t>((m_packed->bits.bits | shifted(set)) & static_cast<storage_t>(~shifted(reset))));
+	return *this;
+}
+template <typename Packed, std::size_t I>
+constexpr packed_flags_ref<Packed, I>& packed_flags_ref<Packed, I>::operator&=(flags_t flags) noexcept {
+	// keep other fields, intersect this one
+	write(static_cast<storage_t>(m_packed->bits.bits & static_cast<storage_t>(~Packed::template mask<I>() | shifted(flags))));
+	return *this;
+}
+} // namespace kt
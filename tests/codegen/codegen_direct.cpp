@@ -0,0 +1,28 @@
+// C++20 direct overloads (flags-typed masks, no make() round trip) vs hand-written integer code, built at -Og:
+// without KT_FLAGS_CONCEPTS the generic T overloads leave make() calls in place at this level (all() is omitted: GCC swaps the cmp operands)
+#include <cstdint>
+#include "enum_flags.hpp"
+#include "uint_flags.hpp"
+
+// KT_FLAGS_NO_CONCEPTS builds the generic path for comparison (enum-flags-codegen-report in bench/)
+#if !defined(KT_FLAGS_CONCEPTS) && !defined(KT_FLAGS_NO_CONCEPTS)
+#error "codegen_direct requires C++20 concepts"
+#endif
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+
+using linear_flags = kt::enum_flags<linear_e, std::uint32_t>;
+using uflags = kt::uint_flags<std::uint32_t>;
+} // namespace
+
+#define KT_CODEGEN_PAIR(name, Flags, kt_expr, raw_expr)                                                                                               \
+	extern "C" auto kt_##name(Flags x, Flags m) { return kt_expr; }                                                                                    \
+	extern "C" auto raw_##name(std::uint32_t x, std::uint32_t m) { return raw_expr; }
+
+KT_CODEGEN_PAIR(linear_or, linear_flags, static_cast<std::uint32_t>(x |= m), x | m)
+KT_CODEGEN_PAIR(linear_and, linear_flags, static_cast<std::uint32_t>(x &= m), x & m)
+KT_CODEGEN_PAIR(linear_xor, linear_flags, static_cast<std::uint32_t>(x ^= m), x ^ m)
+KT_CODEGEN_PAIR(linear_any, linear_flags, x.any(m), (x & m) != 0)
+KT_CODEGEN_PAIR(uint_or, uflags, (x |= m).bits, x | m)
+KT_CODEGEN_PAIR(uint_any, uflags, x.any(m), (x & m) != 0)
@@ -0,0 +1,39 @@
+// Disabled instrumentation must compile to the uninstrumented code: cold_e ops are compared against hand-written integer code
+// in a TU that also instruments another enum (flag_counters included, hooks instantiated)
+#include <cstddef>
+#include <cstdint>
+#include "flag_counters.hpp"
+
+namespace {
+enum class hot_e { a, b, c, d, eCOUNT_ };
+enum class cold_e { a, b, c, d, eCOUNT_ };
+} // namespace
+
+template <>
+struct kt::instrument_flags<hot_e> : std::true_type {};
+
+namespace {
+using hot_flags = kt::enum_flags<hot_e, std::uint32_t>;
+using cold_flags = kt::enum_flags<cold_e, std::uint32_t>;
+} // namespace
+
+// instrumented counterpart: keeps the record() hooks instantiated in this TU
+extern "C" bool hot_ops(std::uint32_t x) {
+	auto f = hot_flags::from_value(x);
+	f.set(hot_e::a).reset(hot_e::b);
+	return f.test(hot_e::c) && f.any(hot_flags(hot_e::d)) && f.all(hot_flags(hot_e::a));
+}
+
+#define KT_CODEGEN_PAIR(name, kt_expr, raw_expr)                                                                                                       \
+	extern "C" auto kt_##name(std::uint32_t x) { return kt_expr; }                                                                                     \
+	extern "C" auto raw_##name(std::uint32_t x) { return raw_expr; }
+
+KT_CODEGEN_PAIR(cold_set, static_cast<std::uint32_t>(cold_flags::from_value(x).set(cold_e::a, cold_e::c)), x | 5u)
+KT_CODEGEN_PAIR(cold_reset, static_cast<std::uint32_t>(cold_flags::from_value(x).reset(cold_e::b)), x & ~2u)
+KT_CODEGEN_PAIR(cold_test, cold_flags::from_value(x).test(cold_e::d), (x & 8u) != 0)
+KT_CODEGEN_PAIR(cold_any, cold_flags::from_value(x).any(cold_flags::make(cold_e::a, cold_e::b)), (x & 3u) != 0)
+KT_CODEGEN_PAIR(cold_all, cold_flags::from_value(x).all(cold_flags::make(cold_e::a, cold_e::b)), (x & 3u) == 3u)
+KT_CODEGEN_PAIR(cold_set_ct, static_cast<std::uint32_t>(cold_flags::from_value(x).set<cold_e::b>()), x | 2u)
+KT_CODEGEN_PAIR(cold_reset_ct, static_cast<std::uint32_t>(cold_flags::from_value(x).reset<cold_e::b>()), x & ~2u)
+KT_CODEGEN_PAIR(cold_any_ct, (cold_flags::from_value(x).any<cold_e::a, cold_e::d>()), (x & 9u) != 0)
+KT_CODEGEN_PAIR(cold_all_ct, (cold_flags::from_value(x).all<cold_e::a, cold_e::d>()), (x & 9u) == 9u)
@@ -0,0 +1,83 @@
+// Each kt_<op> is compared against raw_<op> (hand-written integer code) by compare.cmake: instruction streams must be identical at -O2
+#include <cstddef>
+#include <cstdint>
+#include "enum_flags.hpp"
+#include "flag_batch.hpp"
+#include "uint_flags.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+enum class pot_e : std::uint64_t { a = 1, b = 2, c = 4, d = 8, eCOUNT_ = 16 };
+
+using linear_flags = kt::enum_flags<linear_e, std::uint32_t>;
+using pot_flags = kt::enum_flags<pot_e, std::uint64_t, kt::enum_trait_pot>;
+using uflags = kt::uint_flags<std::uint16_t>;
+} // namespace
+
+// raw loops mirror flag_batch's omp simd annotation when it is enabled
+#if defined(_OPENMP) || defined(KT_FLAGS_OPENMP_SIMD)
+#define KT_CODEGEN_PRAGMA(x) _Pragma(#x)
+#define KT_CODEGEN_SIMD(clause) KT_CODEGEN_PRAGMA(omp simd clause)
+#else
+#define KT_CODEGEN_SIMD(clause)
+#endif
+
+#define KT_CODEGEN_PAIR(name, Ty, kt_expr, raw_expr)                                                                                                  \
+	extern "C" auto kt_##name(Ty x) { return kt_expr; }                                                                                                \
+	extern "C" auto raw_##name(Ty x) { return raw_expr; }
+
+// enum_flags, linear
+KT_CODEGEN_PAIR(linear_test, std::uint32_t, linear_flags::from_value(x).test(linear_e::c), (x & 4u) != 0)
+KT_CODEGEN_PAIR(linear_make, std::uint32_t, static_cast<std::uint32_t>(linear_flags::make(linear_e::a, linear_e::d)) | x, x | 9u)
+KT_CODEGEN_PAIR(linear_set, std::uint32_t, static_cast<std::uint32_t>(linear_flags::from_value(x).set(linear_e::a, linear_e::d)), x | 9u)
+KT_CODEGEN_PAIR(linear_reset, std::uint32_t, static_cast<std::uint32_t>(linear_flags::from_value(x).reset(linear_e::b)), x & ~2u)
+KT_CODEGEN_PAIR(linear_set_ct, std::uint32_t, static_cast<std::uint32_t>(linear_flags::from_value(x).set<linear_e::a, linear_e::d>()), x | 9u)
+KT_CODEGEN_PAIR(linear_update, std::uint32_t,
+				static_cast<std::uint32_t>(linear_flags::from_value(x).update(linear_flags(linear_e::a), linear_flags(linear_e::b))), [x] {
+					auto ret = x;
+					ret |= 1u;
+					ret &= ~2u;
+					return ret;
+				}())
+KT_CODEGEN_PAIR(linear_any, std::uint32_t, linear_flags::from_value(x).any(linear_flags::make(linear_e::a, linear_e::b)), (x & 3u) != 0)
+KT_CODEGEN_PAIR(linear_all, std::uint32_t, linear_flags::from_value(x).all(linear_flags::make(linear_e::a, linear_e::b)), (x & 3u) == 3u)
+KT_CODEGEN_PAIR(linear_any_ct, std::uint32_t, (linear_flags::from_value(x).any<linear_e::a, linear_e::b>()), (x & 3u) != 0)
+KT_CODEGEN_PAIR(linear_count, std::uint32_t, linear_flags::from_value(x).count(), static_cast<std::size_t>(__builtin_popcount(x)))
+KT_CODEGEN_PAIR(linear_or, std::uint32_t, static_cast<std::uint32_t>(linear_flags::from_value(x) | linear_flags(linear_e::h)), x | 0x80u)
+KT_CODEGEN_PAIR(linear_xor, std::uint32_t, static_cast<std::uint32_t>(linear_flags::from_value(x) ^ linear_flags(linear_e::h)), x ^ 0x80u)
+KT_CODEGEN_PAIR(linear_apply, std::uint32_t, static_cast<std::uint32_t>(linear_flags::from_value(x).apply(kt::set(linear_e::a) | kt::flip(linear_e::b))),
+				(x & ~1u) ^ 3u) // set then flip folds into one and + xor
+
+// enum_flags, pot
+KT_CODEGEN_PAIR(pot_test, std::uint64_t, pot_flags::from_value(x).test(pot_e::c), (x & 4u) != 0)
+KT_CODEGEN_PAIR(pot_set, std::uint64_t, static_cast<std::uint64_t>(pot_flags::from_value(x).set(pot_e::a, pot_e::d)), x | 9u)
+KT_CODEGEN_PAIR(pot_all, std::uint64_t, pot_flags::from_value(x).all(pot_flags::make(pot_e::b, pot_e::c)), (x & 6u) == 6u)
+KT_CODEGEN_PAIR(pot_count, std::uint64_t, pot_flags::from_value(x).count(), static_cast<std::size_t>(__builtin_popcountll(x)))
+
+// uint_flags
+KT_CODEGEN_PAIR(uint_set, std::uint16_t, uflags::from_value(x).set(std::uint16_t{9}).bits, static_cast<std::uint16_t>(x | 9u))
+KT_CODEGEN_PAIR(uint_any, std::uint16_t, uflags::from_value(x).any(std::uint16_t{0x300}), (x & 0x300u) != 0)
+KT_CODEGEN_PAIR(uint_count, std::uint16_t, uflags::from_value(x).count(), static_cast<std::size_t>(__builtin_popcount(x)))
+
+// bulk
+extern "C" std::uint32_t kt_reduce_or(linear_flags const* data, std::size_t count) { return static_cast<std::uint32_t>(kt::reduce_or(data, count)); }
+extern "C" std::uint32_t raw_reduce_or(std::uint32_t const* data, std::size_t count) {
+	std::uint32_t ret{};
+	KT_CODEGEN_SIMD(reduction(| : ret))
+	for (std::size_t i = 0; i < count; ++i) { ret |= data[i]; }
+	return ret;
+}
+extern "C" std::size_t kt_batch_count_all(linear_flags const* data, std::size_t count) {
+	return kt::batch_count_all(data, count, linear_flags::make(linear_e::a, linear_e::c));
+}
+extern "C" std::size_t raw_batch_count_all(std::uint32_t const* data, std::size_t count) {
+	std::size_t ret{};
+	KT_CODEGEN_SIMD(reduction(+ : ret))
+	for (std::size_t i = 0; i < count; ++i) { ret += static_cast<std::size_t>((data[i] & 5u) == 5u); }
+	return ret;
+}
+extern "C" void kt_batch_set(linear_flags* data, std::size_t count) { kt::batch_set(data, count, linear_flags(linear_e::h)); }
+extern "C" void raw_batch_set(std::uint32_t* data, std::size_t count) {
+	KT_CODEGEN_SIMD()
+	for (std::size_t i = 0; i < count; ++i) { data[i] |= 0x80u; }
+}
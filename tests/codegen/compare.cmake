@@ -0,0 +1,76 @@
+# Compare disassembly of kt_<op> against raw_<op> in OBJECT (cmake -DOBJDUMP=<objdump> -DOBJECT=<file> -P compare.cmake)
+# Addresses, padding and jump targets are normalized; relocations (call targets) are kept and must match
+# -DREPORT=ON only prints instruction counts per pair and never fails
+
+if(NOT OBJDUMP OR NOT OBJECT)
+  message(FATAL_ERROR "OBJDUMP and OBJECT are required")
+endif()
+
+execute_process(COMMAND "${OBJDUMP}" -dr --no-show-raw-insn "${OBJECT}" OUTPUT_VARIABLE disassembly RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${OBJDUMP} failed: ${result}")
+endif()
+
+string(REPLACE ";" "," disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+
+set(functions)
+set(current)
+foreach(line IN LISTS lines)
+  if(line MATCHES "^[0-9a-f]+ <([A-Za-z_0-9.]+)>:$")
+    set(current "${CMAKE_MATCH_1}")
+    list(APPEND functions "${current}")
+    set("body_${current}" "")
+  elseif(current AND line MATCHES "^[ \t]+[0-9a-f]+:[ \t]+(R_[A-Z0-9_]+)[ \t]+(.*)$")
+    string(APPEND "body_${current}" "  reloc ${CMAKE_MATCH_1} ${CMAKE_MATCH_2}\n")
+  elseif(current AND line MATCHES "^[ \t]+[0-9a-f]+:\t(.*)$")
+    set(insn "${CMAKE_MATCH_1}")
+    string(REGEX REPLACE "[ \t]*#.*$" "" insn "${insn}")
+    string(REGEX REPLACE "[0-9a-f]+ <[A-Za-z_0-9.]+((\\+0x[0-9a-f]+)?)>" "<\\1>" insn "${insn}")
+    string(REGEX REPLACE "[ \t]+" " " insn "${insn}")
+    string(STRIP "${insn}" insn)
+    if(insn STREQUAL "" OR insn MATCHES "^(nop|xchg %ax,%ax|int3|data16|cs nop|ds nop)")
+      continue()
+    endif()
+    string(APPEND "body_${current}" "  ${insn}\n")
+  endif()
+endforeach()
+
+set(pairs 0)
+set(failures 0)
+foreach(function IN LISTS functions)
+  if(NOT function MATCHES "^kt_(.+)$")
+    continue()
+  endif()
+  set(op "${CMAKE_MATCH_1}")
+  list(FIND functions "raw_${op}" index)
+  if(index EQUAL -1)
+    message(SEND_ERROR "${op}: raw_${op} not found")
+    math(EXPR failures "${failures} + 1")
+    continue()
+  endif()
+  math(EXPR pairs "${pairs} + 1")
+  string(REGEX MATCHALL "\n" kt_lines "${body_kt_${op}}")
+  list(LENGTH kt_lines kt_count)
+  string(REGEX MATCHALL "\n" raw_lines "${body_raw_${op}}")
+  list(LENGTH raw_lines raw_count)
+  if(REPORT)
+    message(STATUS "${op}: kt ${kt_count} vs raw ${raw_count} instructions")
+  elseif(NOT body_kt_${op} STREQUAL body_raw_${op})
+    message(SEND_ERROR "${op}: kt ${kt_count} vs raw ${raw_count} instructions\nkt_${op}:\n${body_kt_${op}}raw_${op}:\n${body_raw_${op}}")
+    math(EXPR failures "${failures} + 1")
+  else()
+    message(STATUS "${op}: identical (${kt_count} instructions)")
+  endif()
+endforeach()
+
+if(pairs EQUAL 0)
+  message(FATAL_ERROR "No kt_ / raw_ pairs found in ${OBJECT}")
+endif()
+if(REPORT)
+  return()
+endif()
+if(failures GREATER 0)
+  message(FATAL_ERROR "${failures} of ${pairs} pairs differ")
+endif()
+message(STATUS "${pairs} pairs identical")
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdio>
+
+// Checks are constexpr bool functions: KT_CHECK returns false from the enclosing check on failure.
+// Each check runs twice: at compile time through static_assert, and at run time (intrinsic paths) through run_checks.
+
+#define KT_CHECK(expr)                                                                                                                                 \
+	do {                                                                                                                                               \
+		if (!(expr)) { return false; }                                                                                                                 \
+	} while (false)
+
+#define KT_CONSTEXPR_CHECK(check) static_assert(check(), #check " failed at compile time")
+
+namespace kt::test {
+struct check_t {
+	char const* name;
+	bool (*func)();
+};
+
+template <std::size_t N>
+int run_checks(check_t const (&checks)[N]) {
+	int ret = 0;
+	for (auto const& check : checks) {
+		if (!check.func()) {
+			std::fprintf(stderr, "FAILED: %s\n", check.name);
+			ret = 1;
+		}
+	}
+	return ret;
+}
+} // namespace kt::test
+
+#define KT_RUN_CHECK(check)                                                                                                                            \
+	kt::test::check_t { #check, &check }
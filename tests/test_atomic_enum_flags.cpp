@@ -0,0 +1,104 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "atomic_enum_flags.hpp"
+#include "test.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+enum class pot_e : std::uint8_t { a = 1, b = 2, c = 4, eCOUNT_ = 8 };
+
+using atomic_t = kt::atomic_enum_flags<linear_e, std::uint16_t>;
+using flags_t = atomic_t::flags_t;
+
+bool check_modifiers() {
+	atomic_t a(flags_t(linear_e::a));
+	// call sites read like enum_flags: enumerators are mask inputs, never memory orders
+	KT_CHECK(a.set(linear_e::b, linear_e::c) == flags_t(linear_e::a));
+	KT_CHECK(a.load() == flags_t::make(linear_e::a, linear_e::b, linear_e::c));
+	KT_CHECK(a.reset(linear_e::a, linear_e::c) == flags_t::make(linear_e::a, linear_e::b, linear_e::c));
+	KT_CHECK(a.flip(linear_e::b, linear_e::h) == flags_t(linear_e::b) && a.load() == flags_t(linear_e::h));
+	// explicit memory order through the enum_flags overloads
+	a.set(flags_t::make(linear_e::d, linear_e::e), std::memory_order_release);
+	a.set(linear_e::f, std::memory_order_relaxed);
+	KT_CHECK(a.load(std::memory_order_acquire) == flags_t::make(linear_e::d, linear_e::e, linear_e::f, linear_e::h));
+	a.reset(flags_t(linear_e::h), std::memory_order_relaxed);
+	a.flip(linear_e::d, std::memory_order_acq_rel);
+	KT_CHECK(a.load() == flags_t::make(linear_e::e, linear_e::f));
+	KT_CHECK(a.update(flags_t(linear_e::a), flags_t(linear_e::e)) == flags_t::make(linear_e::e, linear_e::f));
+	KT_CHECK(a.load() == flags_t::make(linear_e::a, linear_e::f));
+	KT_CHECK(a.exchange(flags_t(linear_e::g)) == flags_t::make(linear_e::a, linear_e::f));
+	a.store(flags_t::make(linear_e::a, linear_e::b, linear_e::c));
+	KT_CHECK(a.apply(kt::set(linear_e::h) | kt::reset(linear_e::a) | kt::flip(linear_e::b, linear_e::d)) == flags_t::make(linear_e::a, linear_e::b, linear_e::c));
+	KT_CHECK(a.load() == flags_t::make(linear_e::c, linear_e::d, linear_e::h));
+	return true;
+}
+
+bool check_queries() {
+	atomic_t a(flags_t::make(linear_e::b, linear_e::d));
+	KT_CHECK(a.test(linear_e::b) && !a.test(linear_e::a) && a.test(linear_e::d, std::memory_order_acquire));
+	KT_CHECK(a.any() && a.any(linear_e::a, linear_e::d) && !a.any(linear_e::a, linear_e::c));
+	KT_CHECK(a.all(linear_e::b, linear_e::d) && !a.all(linear_e::b, linear_e::c) && a.all(flags_t(linear_e::b), std::memory_order_relaxed));
+	KT_CHECK(!atomic_t{}.any());
+	kt::atomic_enum_flags<pot_e, std::uint8_t, kt::enum_trait_pot> pot;
+	pot.set(pot_e::a, pot_e::c);
+	KT_CHECK(static_cast<std::uint8_t>(pot.load()) == 5 && pot.all(pot_e::a, pot_e::c));
+	return true;
+}
+
+bool check_fetch_or() {
+	// each thread owns two bits and sets / resets them repeatedly; fetch_or / fetch_and never lose another thread's bits
+	atomic_t a;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&a, t] {
+			auto const lo = static_cast<linear_e>(t * 2);
+			auto const hi = static_cast<linear_e>(t * 2 + 1);
+			for (int i = 0; i < 10'000; ++i) {
+				a.set(lo, hi);
+				a.reset(lo, hi);
+			}
+			a.set(lo, hi);
+		});
+	}
+	for (auto& thread : threads) { thread.join(); }
+	KT_CHECK(a.load() == flags_t::from_value(0xff));
+	return true;
+}
+
+bool check_cas_update() {
+	// a token bit moves between threads through update(set, reset): exactly one holder at any time
+	atomic_t a(flags_t(linear_e::a));
+	std::atomic<bool> lost_token{};
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 3; ++t) {
+		threads.emplace_back([&a, &lost_token, t] {
+			auto const from = static_cast<linear_e>(t);
+			auto const to = static_cast<linear_e>((t + 1) % 3);
+			for (int moved = 0; moved < 2'000;) {
+				if (!a.test(from, std::memory_order_relaxed)) {
+					std::this_thread::yield();
+					continue;
+				}
+				auto const previous = a.update(flags_t(to), flags_t(from), std::memory_order_acq_rel);
+				if (previous != flags_t(from)) { lost_token = true; }
+				++moved;
+			}
+		});
+	}
+	for (auto& thread : threads) { thread.join(); }
+	KT_CHECK(!lost_token && a.load() == flags_t(linear_e::a));
+	return true;
+}
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_modifiers),
+		KT_RUN_CHECK(check_queries),
+		KT_RUN_CHECK(check_fetch_or),
+		KT_RUN_CHECK(check_cas_update),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,187 @@
+#include <cstdint>
+#include "enum_flags.hpp"
+#include "test.hpp"
+#include "uint_flags.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+enum class pot_e : std::uint32_t { a = 1 << 0, b = 1 << 1, c = 1 << 2, d = 1 << 3, eCOUNT_ = 1 << 4 };
+enum class ranged_e { none, first, second, third, eCOUNT_ };
+enum class big_e { e0, e63 = 63, e64, e99 = 99, eCOUNT_ };
+enum class high_e { e0, e31 = 31, e32, e63 = 63, eCOUNT_ };
+
+template <typename Ty>
+using linear_flags = kt::enum_flags<linear_e, Ty>;
+using pot_flags = kt::enum_flags<pot_e, std::uint8_t, kt::enum_trait_pot>;
+using lut_flags = kt::enum_flags<ranged_e, std::uint8_t, kt::enum_trait_lut<ranged_e::first>>;
+using wide_t = kt::wide_flags<big_e>;
+using high_flags = kt::enum_flags<high_e, std::uint64_t>;
+using high_lut_flags = kt::enum_flags<high_e, std::uint64_t, kt::enum_trait_lut<high_e::e0>>;
+
+template <typename Ty>
+constexpr bool check_linear() {
+	using flags_t = linear_flags<Ty>;
+	constexpr auto ab = flags_t::make(linear_e::a, linear_e::b);
+	KT_CHECK(static_cast<Ty>(ab) == 3);
+	KT_CHECK(ab.test(linear_e::a) && ab[linear_e::b] && !ab.test(linear_e::c));
+	KT_CHECK(ab.count() == 2);
+	KT_CHECK(ab.any() && !flags_t{}.any());
+	KT_CHECK(ab.any(linear_e::b) && !ab.any(linear_e::h));
+	KT_CHECK(ab.all(flags_t::make(linear_e::a, linear_e::b)) && !ab.all(flags_t::make(linear_e::a, linear_e::c)));
+	KT_CHECK(flags_t(linear_e::h).has_single_bit() && !ab.has_single_bit());
+	KT_CHECK(flags_t::from_value(static_cast<Ty>(0x81)) == flags_t::make(linear_e::a, linear_e::h));
+
+	auto f = ab;
+	f.set(linear_e::h).reset(linear_e::a);
+	KT_CHECK(f == flags_t::make(linear_e::b, linear_e::h));
+	f.update(flags_t(linear_e::c), flags_t(linear_e::b));
+	KT_CHECK(f == flags_t::make(linear_e::c, linear_e::h));
+	f.assign(flags_t::make(linear_e::d, linear_e::h), false);
+	KT_CHECK(f == flags_t(linear_e::c));
+	f.template set<linear_e::e, linear_e::f>();
+	KT_CHECK((f.template all<linear_e::e, linear_e::f>() && !f.template any<linear_e::a, linear_e::b>()));
+	f.template reset<linear_e::c>();
+	KT_CHECK((f == kt::mask_v<flags_t, linear_e::e, linear_e::f>));
+
+	KT_CHECK((ab | flags_t(linear_e::c)).count() == 3);
+	KT_CHECK((ab & flags_t(linear_e::b)) == flags_t(linear_e::b));
+	KT_CHECK((ab ^ flags_t(linear_e::b)) == flags_t(linear_e::a));
+	f = ab;
+	f |= linear_e::d;
+	f &= flags_t::make(linear_e::a, linear_e::d);
+	f ^= linear_e::g;
+	KT_CHECK(f == flags_t::make(linear_e::a, linear_e::d, linear_e::g));
+
+	f = flags_t::make(linear_e::a, linear_e::b, linear_e::c);
+	f.apply(kt::set(linear_e::h) | kt::reset(linear_e::a) | kt::flip(linear_e::b, linear_e::d));
+	KT_CHECK(f == flags_t::make(linear_e::c, linear_e::d, linear_e::h));
+
+	std::size_t bits{};
+	std::size_t sum{};
+	for (auto const e : f.set_bits()) {
+		++bits;
+		sum += static_cast<std::size_t>(e);
+	}
+	KT_CHECK(bits == 3 && sum == 2 + 3 + 7);
+	return true;
+}
+
+// shifts at and above 32 on 64-bit storage
+template <typename Flags>
+constexpr bool check_high() {
+	constexpr auto f = Flags::make(high_e::e31, high_e::e32, high_e::e63);
+	KT_CHECK(static_cast<std::uint64_t>(f) == (std::uint64_t{1} << 31 | std::uint64_t{1} << 32 | std::uint64_t{1} << 63));
+	KT_CHECK(f.test(high_e::e32) && f.test(high_e::e63) && !f.test(high_e::e0) && !f.test(static_cast<high_e>(33)));
+	KT_CHECK(f.count() == 3 && Flags(high_e::e63).has_single_bit());
+	KT_CHECK(Flags::from_value(std::uint64_t{1} << 32) == Flags(high_e::e32));
+	std::size_t bits{};
+	std::size_t sum{};
+	for (auto const e : f.set_bits()) {
+		++bits;
+		sum += static_cast<std::size_t>(e);
+	}
+	KT_CHECK(bits == 3 && sum == 31 + 32 + 63);
+	auto g = f;
+	g.reset(high_e::e63);
+	g ^= high_e::e0;
+	KT_CHECK(g == Flags::make(high_e::e0, high_e::e31, high_e::e32) && g.count() == 3);
+	return true;
+}
+
+constexpr bool check_pot() {
+	constexpr auto bd = pot_flags::make(pot_e::b, pot_e::d);
+	KT_CHECK(static_cast<std::uint8_t>(bd) == 0xa);
+	KT_CHECK(bd.test(pot_e::b) && !bd.test(pot_e::c));
+	KT_CHECK(bd.count() == 2);
+	KT_CHECK(bd.any(pot_e::d) && bd.all(pot_flags::make(pot_e::b, pot_e::d)));
+	auto f = bd;
+	f.set(pot_e::a).reset(pot_e::d);
+	KT_CHECK(f == pot_flags::make(pot_e::a, pot_e::b));
+	std::size_t bits{};
+	for (auto const e : bd.set_bits()) { bits += static_cast<std::size_t>(e); }
+	KT_CHECK(bits == 0xa);
+	return true;
+}
+
+constexpr bool check_lut() {
+	constexpr auto f = lut_flags::make(ranged_e::first, ranged_e::third);
+	KT_CHECK(static_cast<std::uint8_t>(f) == 0x5);
+	KT_CHECK(f.test(ranged_e::third) && !f.test(ranged_e::second));
+	KT_CHECK(f.count() == 2);
+	std::size_t sum{};
+	for (auto const e : f.set_bits()) { sum += static_cast<std::size_t>(e); }
+	KT_CHECK(sum == 1 + 3);
+	return true;
+}
+
+constexpr bool check_uint() {
+	using flags_t = kt::uint_flags<std::uint16_t>;
+	auto f = flags_t::from_value(0x0101);
+	KT_CHECK(f.count() == 2 && f[std::uint16_t{0x0100}]);
+	f.set(std::uint16_t{0x8000});
+	KT_CHECK(f.bits == 0x8101);
+	f.update(std::uint16_t{0x0002}, std::uint16_t{0x0001});
+	KT_CHECK(f.bits == 0x8102);
+	KT_CHECK(f.any(std::uint16_t{0x0002}) && !f.all(std::uint16_t{0x0003}));
+	f.reset(std::uint16_t{0x8000});
+	KT_CHECK(f.bits == 0x0102 && !f.has_single_bit());
+	return true;
+}
+
+constexpr bool check_wide() {
+	auto f = wide_t::make(big_e::e0, big_e::e63, big_e::e64, big_e::e99);
+	KT_CHECK(f.count() == 4);
+	KT_CHECK(f.test(big_e::e64) && f.test(big_e::e99) && !f.test(static_cast<big_e>(65)));
+	f.reset(big_e::e63);
+	KT_CHECK(f.count() == 3 && !f.test(big_e::e63));
+	KT_CHECK(f.any(big_e::e99) && f.all(wide_t::make(big_e::e0, big_e::e64)));
+	std::size_t last{};
+	for (auto const e : f.set_bits()) { last = static_cast<std::size_t>(e); }
+	KT_CHECK(last == 99);
+	return true;
+}
+
+constexpr bool check_bit_utils() {
+	KT_CHECK(kt::detail::popcount(std::uint8_t{0xff}) == 8);
+	KT_CHECK(kt::detail::popcount(std::uint64_t{0x8000'0000'0000'0001}) == 2);
+	KT_CHECK(kt::detail::countr_zero(std::uint32_t{0x100}) == 8);
+	KT_CHECK(kt::detail::countr_zero(std::uint16_t{}) == 16);
+	KT_CHECK(kt::detail::has_single_bit(std::uint64_t{1} << 63) && !kt::detail::has_single_bit(std::uint8_t{}));
+	KT_CHECK(kt::detail::pext(std::uint32_t{0b1011'0110}, std::uint32_t{0b1111'0000}) == 0b1011);
+	KT_CHECK(kt::detail::pdep(std::uint32_t{0b1011}, std::uint32_t{0b1111'0000}) == 0b1011'0000);
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_linear<std::uint8_t>);
+KT_CONSTEXPR_CHECK(check_linear<std::uint16_t>);
+KT_CONSTEXPR_CHECK(check_linear<std::uint32_t>);
+KT_CONSTEXPR_CHECK(check_linear<std::uint64_t>);
+KT_CONSTEXPR_CHECK(check_high<high_flags>);
+KT_CONSTEXPR_CHECK(check_high<high_lut_flags>);
+KT_CONSTEXPR_CHECK(check_pot);
+KT_CONSTEXPR_CHECK(check_lut);
+KT_CONSTEXPR_CHECK(check_uint);
+KT_CONSTEXPR_CHECK(check_wide);
+KT_CONSTEXPR_CHECK(check_bit_utils);
+
+static_assert(sizeof(linear_flags<std::uint8_t>) == 1 && sizeof(linear_flags<std::uint64_t>) == 8);
+static_assert(std::is_same_v<kt::auto_flags<linear_e>::storage_t, std::uint8_t>);
+static_assert(std::is_same_v<kt::auto_flags<big_e>::storage_t, kt::wide_bits<2>>);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_linear<std::uint8_t>),
+		KT_RUN_CHECK(check_linear<std::uint16_t>),
+		KT_RUN_CHECK(check_linear<std::uint32_t>),
+		KT_RUN_CHECK(check_linear<std::uint64_t>),
+		KT_RUN_CHECK(check_high<high_flags>),
+		KT_RUN_CHECK(check_high<high_lut_flags>),
+		KT_RUN_CHECK(check_pot),
+		KT_RUN_CHECK(check_lut),
+		KT_RUN_CHECK(check_uint),
+		KT_RUN_CHECK(check_wide),
+		KT_RUN_CHECK(check_bit_utils),
+	};
+	return kt::test::run_checks(checks);
+}
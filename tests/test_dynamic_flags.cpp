@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <memory_resource>
+#include "dynamic_flags.hpp"
+#include "enum_flags.hpp"
+#include "test.hpp"
+#include "uint_flags.hpp"
+
+namespace {
+enum class big_e { e0, e63 = 63, e64, e150 = 150, eCOUNT_ };
+
+using wide_t = kt::wide_flags<big_e>;
+
+bool check_owning() {
+	kt::dynamic_flags f(200);
+	KT_CHECK(f.size() == 200 && !f.is_inline() && !f.any());
+	f.set(0, 64, 199, 200);
+	KT_CHECK(f.count() == 3 && f.test(199) && !f.test(200));
+	f.flip(64).reset(0);
+	KT_CHECK(f.count() == 1);
+	std::size_t last{};
+	for (auto const i : f.set_bits()) { last = i; }
+	KT_CHECK(last == 199);
+
+	kt::dynamic_flags mask(100);
+	mask.set(1, 99);
+	f |= mask;
+	KT_CHECK(f.all(mask) && f.any(mask) && f.count() == 3);
+	f &= mask;
+	KT_CHECK(f.count() == 2 && !f.test(199));
+	f ^= mask;
+	KT_CHECK(!f.any());
+
+	f.resize(64);
+	KT_CHECK(f.size() == 64 && f.word_count() == 1);
+	kt::dynamic_flags const copy = f;
+	KT_CHECK(copy == f);
+	return true;
+}
+
+bool check_view() {
+	auto src = wide_t::make(big_e::e0, big_e::e64, big_e::e150);
+	auto const view = kt::dynamic_flags_view::of(src);
+	KT_CHECK(view.size() == 192 && view.words() == reinterpret_cast<std::uint64_t const*>(&src)); // no copy
+	KT_CHECK(view.count() == 3 && view.test(150) && !view.test(63));
+	src.set(big_e::e63);
+	KT_CHECK(view.test(63) && view.count() == 4); // reads the source in place
+	KT_CHECK(view.to_flags<wide_t>() == src);
+
+	auto const u64 = kt::uint_flags<std::uint64_t>::from_value(0x8000'0000'0000'0001);
+	auto const narrow = kt::dynamic_flags_view::of(u64);
+	KT_CHECK(narrow.size() == 64 && narrow.count() == 2 && narrow.test(63));
+
+	// owning flags accept views for queries and bitwise ops, and copy them on construction
+	kt::dynamic_flags f(view);
+	KT_CHECK(f.view() == view && f.words() != view.words());
+	kt::dynamic_flags g(64);
+	g |= narrow;
+	KT_CHECK(g.all(narrow) && f.all(g) && !g.all(f));
+	KT_CHECK(kt::dynamic_flags::from_flags(src).view() == view);
+	return true;
+}
+
+bool check_pmr() {
+	std::pmr::monotonic_buffer_resource arena;
+	kt::basic_dynamic_flags<std::pmr::polymorphic_allocator<std::uint64_t>> f(1000, &arena);
+	f.set(999);
+	KT_CHECK(f.count() == 1 && f.view().test(999));
+	return true;
+}
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_owning),
+		KT_RUN_CHECK(check_view),
+		KT_RUN_CHECK(check_pmr),
+	};
+	return kt::test::run_checks(checks);
+}
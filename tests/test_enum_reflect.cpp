@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <string_view>
+#include "enum_flags.hpp"
+#include "enum_reflect.hpp"
+#include "flag_names.hpp"
+#include "test.hpp"
+
+namespace {
+enum class sentinel_e { a, b, c, d, e, eCOUNT_ };
+enum class after_e { a, b, eCOUNT_, extra = 7 };
+enum class plain_e { x, y, z };
+enum class gap_e { a = 0, c = 2, f = 5 };
+enum class pot_e : std::uint8_t { a = 1, b = 2, d = 8, eCOUNT_ = 16 };
+enum class pot_plain_e : std::uint16_t { a = 1, b = 0x100 };
+
+using sentinel_t = kt::enum_reflect<sentinel_e>;
+using after_t = kt::enum_reflect<after_e>;
+using plain_t = kt::enum_reflect<plain_e>;
+using gap_t = kt::enum_reflect<gap_e>;
+using pot_t = kt::enum_reflect<pot_e, kt::enum_trait_pot>;
+using pot_plain_t = kt::enum_reflect<pot_plain_e, kt::enum_trait_pot>;
+
+constexpr bool check_sentinel() {
+	KT_CHECK(sentinel_t::count_v == 5 && sentinel_t::values_v[4] == sentinel_e::e);
+	KT_CHECK(sentinel_t::end_v == sentinel_e::eCOUNT_ && sentinel_t::gaps_v == 0 && sentinel_t::is_dense_v);
+	KT_CHECK(sentinel_t::names_v[0] == "a" && sentinel_t::names_v[4] == "e");
+	KT_CHECK(sentinel_t::name(sentinel_e::eCOUNT_).empty() && !sentinel_t::is_valid(sentinel_e::eCOUNT_));
+	KT_CHECK(sentinel_t::index_of(sentinel_e::d) == 3);
+	// the sentinel gets no bit
+	KT_CHECK((kt::detail::auto_storage<sentinel_e, kt::enum_trait_reflect>::bits_v == 5));
+	// values past the sentinel are dropped too
+	KT_CHECK(after_t::count_v == 2 && after_t::end_v == after_e::eCOUNT_ && after_t::name(after_e::extra).empty());
+	return true;
+}
+
+constexpr bool check_no_sentinel() {
+	KT_CHECK(plain_t::count_v == 3 && plain_t::end_v == static_cast<plain_e>(3) && plain_t::is_dense_v);
+	KT_CHECK(plain_t::names_v[0] == "x" && plain_t::names_v[2] == "z");
+	KT_CHECK(kt::enumerate_enum<plain_e>::size() == 3);
+	KT_CHECK((kt::detail::auto_storage<plain_e, kt::enum_trait_linear>::bits_v == 3));
+	return true;
+}
+
+constexpr bool check_gaps() {
+	KT_CHECK(gap_t::count_v == 3 && gap_t::gaps_v == 3 && !gap_t::is_dense_v);
+	KT_CHECK(gap_t::end_v == static_cast<gap_e>(6));
+	KT_CHECK(gap_t::values_v[0] == gap_e::a && gap_t::values_v[1] == gap_e::c && gap_t::values_v[2] == gap_e::f);
+	KT_CHECK(gap_t::names_v[1] == "c" && gap_t::name(gap_e::f) == "f" && gap_t::name(static_cast<gap_e>(1)).empty());
+	KT_CHECK(gap_t::index_of(gap_e::f) == 2 && gap_t::index_of(static_cast<gap_e>(4)) == gap_t::npos);
+	KT_CHECK((kt::detail::auto_storage<gap_e, kt::enum_trait_reflect>::bits_v == 3));
+	KT_CHECK((kt::detail::auto_storage<gap_e, kt::enum_trait_linear>::bits_v == 6));
+	return true;
+}
+
+constexpr bool check_pot() {
+	KT_CHECK(pot_t::scan_v == 8 && pot_t::count_v == 3 && pot_t::gaps_v == 1);
+	KT_CHECK(pot_t::values_v[0] == pot_e::a && pot_t::values_v[2] == pot_e::d && pot_t::end_v == pot_e::eCOUNT_);
+	KT_CHECK(pot_t::name(pot_e::d) == "d" && pot_t::name(static_cast<pot_e>(4)).empty() && pot_t::name(pot_e::eCOUNT_).empty());
+	// not a single bit
+	KT_CHECK(pot_t::index_of(static_cast<pot_e>(3)) == pot_t::npos && pot_t::index_of(pot_e::d) == 2);
+	KT_CHECK(pot_plain_t::count_v == 2 && pot_plain_t::gaps_v == 7 && pot_plain_t::end_v == static_cast<pot_plain_e>(0x200));
+	return true;
+}
+
+template <typename EF, typename Names>
+constexpr bool round_trips(EF flags, Names const& names, std::string_view expected) {
+	char buf[32]{};
+	auto const res = kt::format_flags(flags, names, buf, sizeof(buf));
+	auto const length = static_cast<std::size_t>(res.ptr - buf);
+	KT_CHECK(res.ec == std::errc{} && std::string_view(buf, length) == expected);
+	EF out{};
+	auto const [ptr, ec] = kt::from_chars(buf, buf + length, out, names);
+	return ec == std::errc{} && ptr == buf + length && out == flags;
+}
+
+constexpr bool check_names() {
+	// gapped linear enum: names are indexed by bit, gaps have no name
+	constexpr auto linear = gap_t::names();
+	KT_CHECK(decltype(linear)::size_v == 6 && linear[5] == "f" && linear[1].empty());
+	KT_CHECK(linear.find("f") == 5 && linear.find("") == kt::flag_names<6>::npos);
+	KT_CHECK(round_trips(kt::enum_flags<gap_e>::make(gap_e::f), linear, "f"));
+	KT_CHECK(round_trips(kt::enum_flags<gap_e>::make(gap_e::a, gap_e::c, gap_e::f), linear, "a|c|f"));
+	// reflect layout: bits are dense
+	constexpr auto reflect = kt::enum_reflect<gap_e, kt::enum_trait_reflect>::names();
+	KT_CHECK(decltype(reflect)::size_v == 3 && reflect[2] == "f");
+	KT_CHECK(round_trips(kt::auto_flags<gap_e, kt::enum_trait_reflect>::make(gap_e::c, gap_e::f), reflect, "c|f"));
+	// pot layout: bit i names value 1 << i
+	constexpr auto pot = pot_t::names();
+	KT_CHECK(decltype(pot)::size_v == 4 && pot[3] == "d" && pot[2].empty());
+	KT_CHECK(round_trips(kt::enum_flags<pot_e, std::uint8_t, kt::enum_trait_pot>::make(pot_e::b, pot_e::d), pot, "b|d"));
+	// lut layout: bit i names Begin + i
+	using lut_tr = kt::enum_trait_lut<sentinel_e::c>;
+	constexpr auto lut = kt::enum_reflect<sentinel_e, lut_tr>::names();
+	KT_CHECK(decltype(lut)::size_v == 3 && lut[0] == "c" && lut[2] == "e");
+	KT_CHECK(round_trips(kt::enum_flags<sentinel_e, std::uint8_t, lut_tr>::make(sentinel_e::d), lut, "d"));
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_sentinel);
+KT_CONSTEXPR_CHECK(check_no_sentinel);
+KT_CONSTEXPR_CHECK(check_gaps);
+KT_CONSTEXPR_CHECK(check_pot);
+KT_CONSTEXPR_CHECK(check_names);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_sentinel),
+		KT_RUN_CHECK(check_no_sentinel),
+		KT_RUN_CHECK(check_gaps),
+		KT_RUN_CHECK(check_pot),
+		KT_RUN_CHECK(check_names),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,73 @@
+#include <cstdint>
+#include <iterator>
+#include "enumerate_enum.hpp"
+#include "test.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+enum class pot_e : std::uint16_t { a = 1, b = 2, c = 4, d = 8, e = 16, eCOUNT_ = 32 };
+enum class top_e : std::uint8_t { low = 1, high = 0x80 };
+
+using linear_t = kt::enumerate_enum<linear_e>;
+using offset_t = kt::enumerate_enum<linear_e, linear_e::c, linear_e::g>;
+using pot_t = kt::enumerate_enum<pot_e, pot_e::a, pot_e::eCOUNT_, kt::enum_trait_pot>;
+// End shifted out past the top bit
+using top_t = kt::enumerate_enum<top_e, top_e::low, static_cast<top_e>(0), kt::enum_trait_pot>;
+
+static_assert(std::is_same_v<std::iterator_traits<linear_t::const_iterator>::iterator_category, std::random_access_iterator_tag>);
+
+template <typename Range>
+constexpr bool check_range(std::size_t expected_size) {
+	constexpr auto values = Range::values();
+	KT_CHECK(Range::size() == expected_size && values.size() == expected_size);
+	KT_CHECK(static_cast<std::size_t>(Range::end() - Range::begin()) == expected_size);
+	// naive reference: step one at a time
+	std::size_t count{};
+	for (auto it = Range::begin(); it != Range::end(); ++it) {
+		KT_CHECK(*it == values[count]);
+		KT_CHECK(Range::begin()[static_cast<std::ptrdiff_t>(count)] == *it);
+		KT_CHECK(Range::begin() + static_cast<std::ptrdiff_t>(count) == it && it - static_cast<std::ptrdiff_t>(count) == Range::begin());
+		KT_CHECK(it - Range::begin() == static_cast<std::ptrdiff_t>(count));
+		KT_CHECK(Range::begin() <= it && it < Range::end() && Range::end() > it && !(it > it) && it >= it);
+		++count;
+	}
+	KT_CHECK(count == expected_size);
+	auto it = Range::end();
+	while (it != Range::begin()) { --it; }
+	KT_CHECK(it == Range::begin());
+	it += static_cast<std::ptrdiff_t>(expected_size);
+	KT_CHECK(it == Range::end() && (it -= 1) == Range::end() - 1 && std::distance(Range::begin(), Range::end()) == static_cast<std::ptrdiff_t>(expected_size));
+	return true;
+}
+
+constexpr bool check_linear() {
+	KT_CHECK(check_range<linear_t>(8));
+	KT_CHECK(linear_t::values()[7] == linear_e::h);
+	KT_CHECK(check_range<offset_t>(4));
+	KT_CHECK(offset_t::values()[0] == linear_e::c && offset_t::values()[3] == linear_e::f);
+	auto it = linear_t::begin();
+	KT_CHECK(*it++ == linear_e::a && *it == linear_e::b && *it-- == linear_e::b && *it == linear_e::a);
+	KT_CHECK(*(2 + it) == linear_e::c);
+	return true;
+}
+
+constexpr bool check_pot() {
+	KT_CHECK(check_range<pot_t>(5));
+	KT_CHECK(pot_t::values()[0] == pot_e::a && pot_t::values()[4] == pot_e::e);
+	KT_CHECK(*(pot_t::begin() + 3) == pot_e::d && pot_t::end() - pot_t::begin() == 5);
+	KT_CHECK(check_range<top_t>(8));
+	KT_CHECK(top_t::values()[7] == top_e::high);
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_linear);
+KT_CONSTEXPR_CHECK(check_pot);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_linear),
+		KT_RUN_CHECK(check_pot),
+	};
+	return kt::test::run_checks(checks);
+}
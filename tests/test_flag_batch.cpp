@@ -0,0 +1,74 @@
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "enum_flags.hpp"
+#include "flag_batch.hpp"
+#include "test.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+
+template <typename Ty>
+using linear_flags = kt::enum_flags<linear_e, Ty>;
+
+template <typename Ty>
+constexpr bool check_kernels() {
+	using flags_t = linear_flags<Ty>;
+	std::array<flags_t, 5> data = {
+		flags_t(linear_e::a), flags_t::make(linear_e::a, linear_e::b), flags_t{}, flags_t(linear_e::h), flags_t::make(linear_e::b, linear_e::c),
+	};
+	auto const ab = flags_t::make(linear_e::a, linear_e::b);
+	KT_CHECK(kt::batch_count_all(data.data(), data.size(), ab) == 1);
+	KT_CHECK(kt::batch_count_any(data.data(), data.size(), ab) == 3);
+	KT_CHECK(kt::reduce_or(data.data(), data.size()) == flags_t::make(linear_e::a, linear_e::b, linear_e::c, linear_e::h));
+	KT_CHECK(kt::reduce_and(data.data(), 2) == flags_t(linear_e::a) && kt::reduce_and(data.data(), 0) == flags_t::from_value(static_cast<Ty>(~Ty{})));
+	KT_CHECK(kt::batch_any_mask(data.data(), data.size(), flags_t(linear_e::c)) && !kt::batch_any_mask(data.data(), data.size(), flags_t(linear_e::g)));
+	kt::batch_set(data.data(), data.size(), flags_t(linear_e::d));
+	KT_CHECK(kt::batch_count_all(data.data(), data.size(), flags_t(linear_e::d)) == data.size());
+	kt::batch_reset(data.data(), data.size(), flags_t::make(linear_e::a, linear_e::d));
+	KT_CHECK(data[1] == flags_t(linear_e::b) && data[2] == flags_t{});
+	kt::batch_flip(data.data(), data.size(), flags_t(linear_e::b));
+	KT_CHECK(data[1] == flags_t{} && data[2] == flags_t(linear_e::b) && data[4] == flags_t(linear_e::c));
+	return true;
+}
+
+// large enough for vector bodies and scalar tails on every width
+template <typename Ty>
+bool check_large() {
+	using flags_t = linear_flags<Ty>;
+	std::vector<flags_t> data(1027);
+	for (std::size_t i = 0; i < data.size(); ++i) { data[i] = flags_t::from_value(static_cast<Ty>(i & 0xff)); }
+	std::size_t all_ab{};
+	std::size_t any_h{};
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		all_ab += (i & 3) == 3 ? 1 : 0;
+		any_h += (i & 0x80) != 0 ? 1 : 0;
+	}
+	KT_CHECK(kt::batch_count_all(data.data(), data.size(), flags_t::make(linear_e::a, linear_e::b)) == all_ab);
+	KT_CHECK(kt::batch_count_any(data.data(), data.size(), flags_t(linear_e::h)) == any_h);
+	KT_CHECK(kt::reduce_or(data.data(), data.size()) == flags_t::from_value(0xff));
+	KT_CHECK(kt::reduce_and(data.data() + 255, 1) == flags_t::from_value(0xff) && kt::reduce_and(data.data(), data.size()) == flags_t{});
+	kt::batch_flip(data.data(), data.size(), flags_t(linear_e::a));
+	for (std::size_t i = 0; i < data.size(); ++i) { KT_CHECK(static_cast<Ty>(data[i]) == static_cast<Ty>((i & 0xff) ^ 1)); }
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_kernels<std::uint8_t>);
+KT_CONSTEXPR_CHECK(check_kernels<std::uint16_t>);
+KT_CONSTEXPR_CHECK(check_kernels<std::uint32_t>);
+KT_CONSTEXPR_CHECK(check_kernels<std::uint64_t>);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_kernels<std::uint8_t>),
+		KT_RUN_CHECK(check_kernels<std::uint16_t>),
+		KT_RUN_CHECK(check_kernels<std::uint32_t>),
+		KT_RUN_CHECK(check_kernels<std::uint64_t>),
+		KT_RUN_CHECK(check_large<std::uint8_t>),
+		KT_RUN_CHECK(check_large<std::uint16_t>),
+		KT_RUN_CHECK(check_large<std::uint32_t>),
+		KT_RUN_CHECK(check_large<std::uint64_t>),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,151 @@
+#include <cstdint>
+#include <vector>
+#include "flag_codec.hpp"
+#include "flag_pipeline.hpp"
+#include "test.hpp"
+#include "uint_flags.hpp"
+
+namespace {
+using u8_flags = kt::uint_flags<std::uint8_t>;
+using u16_flags = kt::uint_flags<std::uint16_t>;
+using u64_flags = kt::uint_flags<std::uint64_t>;
+
+template <typename EF, std::size_t N>
+constexpr std::size_t decode(std::uint8_t const (&buf)[N], EF& out) {
+	return kt::decode_varint(buf, N, out);
+}
+
+template <typename EF>
+constexpr bool check_round_trip(typename EF::value_type value) {
+	std::uint8_t buf[kt::varint_max_size_v<EF>]{};
+	auto const written = kt::encode_varint(EF::from_value(value), buf, sizeof(buf));
+	EF out{};
+	KT_CHECK(written > 0 && kt::decode_varint(buf, written, out) == written && out.bits == value);
+	KT_CHECK(written == 1 || kt::decode_varint(buf, written - 1, out) == 0); // truncated
+	return true;
+}
+
+constexpr bool check_varint() {
+	KT_CHECK(check_round_trip<u8_flags>(0) && check_round_trip<u8_flags>(0x7f) && check_round_trip<u8_flags>(0xff));
+	KT_CHECK(check_round_trip<u16_flags>(0x3fff) && check_round_trip<u16_flags>(0xffff));
+	KT_CHECK(check_round_trip<u64_flags>(0) && check_round_trip<u64_flags>(~std::uint64_t{}) && check_round_trip<u64_flags>(std::uint64_t{1} << 63));
+
+	u8_flags u8{};
+	constexpr std::uint8_t u8_max[] = {0xff, 0x01};
+	KT_CHECK(decode(u8_max, u8) == 2 && u8.bits == 0xff);
+	constexpr std::uint8_t u8_overflow[] = {0xff, 0x7f};
+	KT_CHECK(decode(u8_overflow, u8) == 0);
+	constexpr std::uint8_t u8_bit8[] = {0x80, 0x02};
+	KT_CHECK(decode(u8_bit8, u8) == 0);
+	constexpr std::uint8_t u8_overlong[] = {0x81, 0x00};
+	KT_CHECK(decode(u8_overlong, u8) == 0);
+	constexpr std::uint8_t zero[] = {0x00};
+	KT_CHECK(decode(zero, u8) == 1 && u8.bits == 0);
+
+	u16_flags u16{};
+	constexpr std::uint8_t u16_overflow[] = {0xff, 0xff, 0x04};
+	KT_CHECK(decode(u16_overflow, u16) == 0);
+	constexpr std::uint8_t u16_overlong[] = {0x80, 0x80, 0x00};
+	KT_CHECK(decode(u16_overlong, u16) == 0);
+
+	u64_flags u64{};
+	constexpr std::uint8_t u64_max[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01};
+	KT_CHECK(decode(u64_max, u64) == 10 && u64.bits == ~std::uint64_t{});
+	constexpr std::uint8_t u64_overflow[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03};
+	KT_CHECK(decode(u64_overflow, u64) == 0);
+	constexpr std::uint8_t u64_too_long[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+	KT_CHECK(decode(u64_too_long, u64) == 0);
+	return true;
+}
+
+constexpr bool check_delta() {
+	u16_flags const prev[] = {u16_flags::from_value(1), u16_flags::from_value(2), u16_flags::from_value(3), u16_flags::from_value(4)};
+	u16_flags const data[] = {u16_flags::from_value(1), u16_flags::from_value(0x8002), u16_flags::from_value(3), u16_flags::from_value(4)};
+	std::uint8_t buf[16]{};
+	auto const written = kt::encode_delta(data, prev, 4, buf, sizeof(buf));
+	u16_flags out[4]{};
+	KT_CHECK(written && *written > 0 && kt::decode_delta(buf, *written, prev, out, 4) == written);
+	for (std::size_t i = 0; i < 4; ++i) { KT_CHECK(out[i].bits == data[i].bits); }
+	// truncated buffers fail
+	KT_CHECK(!kt::encode_delta(data, prev, 4, buf, *written - 1) && !kt::decode_delta(buf, *written - 1, prev, out, 4));
+	// unchanged: a single run
+	KT_CHECK(kt::encode_delta(prev, prev, 4, buf, sizeof(buf)) == std::size_t{1} && buf[0] == 4);
+	KT_CHECK(kt::decode_delta(buf, 1, prev, out, 4) == std::size_t{1} && out[1].bits == prev[1].bits);
+	return true;
+}
+
+constexpr bool check_delta_empty() {
+	// an empty batch succeeds with 0 bytes, even with no buffer
+	u16_flags const prev[] = {u16_flags::from_value(1)};
+	u16_flags out[1]{};
+	std::uint8_t buf[1]{};
+	KT_CHECK(kt::encode_delta(prev, prev, 0, buf, 0) == std::size_t{0});
+	KT_CHECK(kt::decode_delta(buf, 0, prev, out, 0) == std::size_t{0} && out[0].bits == 0);
+	KT_CHECK(!kt::decode_delta(buf, 0, prev, out, 1));
+	return true;
+}
+
+template <typename EF>
+struct collect_sink {
+	std::vector<typename EF::value_type>* values;
+
+	template <typename Out>
+	void push(EF const* data, std::size_t count, Out&&) {
+		for (std::size_t i = 0; i < count; ++i) { values->push_back(data[i].bits); }
+	}
+	template <typename Out>
+	bool finish(Out&&) noexcept {
+		return true;
+	}
+};
+
+template <typename EF>
+bool decode_stream(std::vector<std::uint8_t> const& bytes, std::size_t split, std::vector<typename EF::value_type>& out) {
+	auto pipeline = kt::pipe(kt::varint_decode_stage<EF, 4>{}, collect_sink<EF>{&out});
+	for (std::size_t i = 0; i < bytes.size(); i += split) { pipeline.push(bytes.data() + i, bytes.size() - i < split ? bytes.size() - i : split); }
+	return pipeline.finish();
+}
+
+bool check_pipeline() {
+	std::vector<std::uint8_t> encoded;
+	std::uint8_t const values[] = {0, 1, 0x7f, 0x80, 0xff, 0x42, 0x81, 0xfe};
+	for (auto const v : values) {
+		std::uint8_t buf[2]{};
+		auto const n = kt::encode_varint(u8_flags::from_value(v), buf, 2);
+		encoded.insert(encoded.end(), buf, buf + n);
+	}
+	for (std::size_t split = 1; split <= encoded.size(); ++split) {
+		std::vector<std::uint8_t> out;
+		KT_CHECK(decode_stream<u8_flags>(encoded, split, out));
+		KT_CHECK(out == std::vector<std::uint8_t>(std::begin(values), std::end(values)));
+	}
+	// malformed streams fail whether or not the bad varint is split across pushes
+	std::vector<std::uint8_t> const malformed[] = {{0x01, 0xff, 0x7f, 0x02}, {0x01, 0x81, 0x00, 0x02}, {0x01, 0x80, 0x02}, {0x01, 0x80}};
+	for (auto const& stream : malformed) {
+		for (std::size_t split = 1; split <= stream.size(); ++split) {
+			std::vector<std::uint8_t> out;
+			KT_CHECK(!decode_stream<u8_flags>(stream, split, out));
+		}
+	}
+	std::vector<std::uint8_t> const u64_overflow = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03};
+	for (std::size_t split = 1; split <= u64_overflow.size(); ++split) {
+		std::vector<std::uint64_t> out;
+		KT_CHECK(!decode_stream<u64_flags>(u64_overflow, split, out));
+	}
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_varint);
+KT_CONSTEXPR_CHECK(check_delta);
+KT_CONSTEXPR_CHECK(check_delta_empty);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_varint),
+		KT_RUN_CHECK(check_delta),
+		KT_RUN_CHECK(check_delta_empty),
+		KT_RUN_CHECK(check_pipeline),
+	};
+	return kt::test::run_checks(checks);
+}
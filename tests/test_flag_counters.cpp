@@ -0,0 +1,72 @@
+#include <cstdint>
+#include "flag_counters.hpp"
+#include "test.hpp"
+
+namespace {
+enum class hot_e { a, b, c, d, eCOUNT_ };
+enum class cold_e { a, b, c, d, eCOUNT_ };
+} // namespace
+
+template <>
+struct kt::instrument_flags<hot_e> : std::true_type {};
+
+namespace {
+using hot_flags = kt::enum_flags<hot_e, std::uint8_t>;
+using cold_flags = kt::enum_flags<cold_e, std::uint8_t>;
+
+std::uint64_t hits(std::size_t bit, kt::flag_hook hook) { return kt::flag_counters<hot_e>::counts(bit)[static_cast<std::size_t>(hook)]; }
+
+constexpr bool check_disabled() {
+	static_assert(!kt::detail::is_instrumented_v<cold_flags> && kt::detail::is_instrumented_v<hot_flags>);
+	auto f = cold_flags::make(cold_e::a);
+	f.set(cold_e::b).reset(cold_e::a);
+	KT_CHECK(f.test(cold_e::b) && f.any(cold_flags(cold_e::b)) && !f.all(cold_flags::make(cold_e::a, cold_e::b)));
+	return true;
+}
+
+// instrumented flags stay usable in constant expressions (recording is skipped)
+constexpr bool check_constexpr_instrumented() {
+	auto f = hot_flags::make(hot_e::a);
+	f.set(hot_e::b);
+	KT_CHECK(f.test(hot_e::b) && f.count() == 2);
+	return true;
+}
+
+bool check_counts() {
+	kt::flag_counters<hot_e>::clear();
+	auto f = hot_flags{};
+	f.set(hot_e::a, hot_e::c);
+	f.set(hot_e::a);
+	f.reset(hot_e::c);
+	KT_CHECK(f.test(hot_e::a) && !f.test(hot_e::c));
+	KT_CHECK(f.any(hot_flags::make(hot_e::b, hot_e::d)) == false);
+	KT_CHECK(f.all(hot_flags(hot_e::a)));
+	f.set<hot_e::d>();
+	KT_CHECK((f.any<hot_e::d>()));
+
+	KT_CHECK(hits(0, kt::flag_hook::set) == 2 && hits(2, kt::flag_hook::set) == 1 && hits(3, kt::flag_hook::set) == 1);
+	KT_CHECK(hits(2, kt::flag_hook::reset) == 1 && hits(0, kt::flag_hook::reset) == 0);
+	KT_CHECK(hits(0, kt::flag_hook::test) == 1 && hits(2, kt::flag_hook::test) == 1);
+	KT_CHECK(hits(1, kt::flag_hook::any) == 1 && hits(3, kt::flag_hook::any) == 2);
+	KT_CHECK(hits(0, kt::flag_hook::all) == 1);
+
+	std::size_t bits{};
+	kt::flag_counters<hot_e>::for_each([&bits](std::size_t, kt::flag_counters<hot_e>::counts_t const&) { ++bits; });
+	KT_CHECK(bits == 4);
+	kt::flag_counters<hot_e>::clear();
+	KT_CHECK(hits(0, kt::flag_hook::set) == 0);
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_disabled);
+KT_CONSTEXPR_CHECK(check_constexpr_instrumented);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_disabled),
+		KT_RUN_CHECK(check_constexpr_instrumented),
+		KT_RUN_CHECK(check_counts),
+	};
+	return kt::test::run_checks(checks);
+}
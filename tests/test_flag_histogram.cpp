@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <vector>
+#include "enum_flags.hpp"
+#include "flag_histogram.hpp"
+#include "test.hpp"
+#include "uint_flags.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+
+template <typename Ty>
+std::vector<kt::uint_flags<Ty>> make_data(std::size_t count) {
+	std::vector<kt::uint_flags<Ty>> ret(count);
+	std::uint64_t state = 0x9e37'79b9'7f4a'7c15ull;
+	for (auto& flags : ret) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		// skew towards low bits so counts differ per bit
+		flags = kt::uint_flags<Ty>::from_value(static_cast<Ty>(state & (state >> 3)));
+	}
+	return ret;
+}
+
+// naive reference: test each bit of each value
+template <typename Hist, typename EF>
+bool matches(Hist const& hist, std::vector<EF> const& data) {
+	KT_CHECK(hist.total() == data.size());
+	for (std::size_t bit = 0; bit < Hist::bits_v; ++bit) {
+		std::uint64_t expected{};
+		for (auto const& flags : data) { expected += (static_cast<typename EF::value_type>(flags) >> bit) & 1; }
+		KT_CHECK(hist[bit] == expected && hist.counts()[bit] == expected);
+	}
+	return true;
+}
+
+struct serial_executor {
+	template <typename F>
+	void operator()(std::size_t count, F&& task) const {
+		for (std::size_t shard = 0; shard < count; ++shard) { task(shard); }
+	}
+};
+
+template <typename Ty>
+bool check_accumulate() {
+	using hist_t = kt::flag_histogram<kt::uint_flags<Ty>>;
+	for (std::size_t const size : {std::size_t{0}, std::size_t{7}, std::size_t{8}, std::size_t{61}, std::size_t{4099}}) {
+		auto const data = make_data<Ty>(size);
+		hist_t bulk;
+		bulk.accumulate(data.data(), data.size());
+		KT_CHECK(matches(bulk, data));
+		hist_t single;
+		for (auto const flags : data) { single.add(flags); }
+		KT_CHECK(matches(single, data));
+	}
+	return true;
+}
+
+bool check_flush() {
+	// more blocks than the carry-save planes hold before a flush
+	auto const data = make_data<std::uint8_t>(600'000);
+	kt::flag_histogram<kt::uint_flags<std::uint8_t>> hist;
+	hist.accumulate(data.data(), data.size());
+	KT_CHECK(matches(hist, data));
+	return true;
+}
+
+bool check_merge() {
+	auto const data = make_data<std::uint16_t>(1000);
+	kt::flag_histogram<kt::uint_flags<std::uint16_t>> lhs, rhs;
+	lhs.accumulate(data.data(), 300);
+	rhs.accumulate(data.data() + 300, 700);
+	KT_CHECK(matches(lhs.merge(rhs), data));
+	lhs.clear();
+	KT_CHECK(lhs.total() == 0 && lhs[3] == 0 && lhs[99] == 0);
+	return true;
+}
+
+bool check_enum_count() {
+	using flags_t = kt::enum_flags<linear_e, std::uint8_t>;
+	std::vector<flags_t> data;
+	for (unsigned v = 0; v < 256; ++v) { data.push_back(flags_t::from_value(static_cast<std::uint8_t>(v))); }
+	kt::flag_histogram<flags_t> hist;
+	hist.accumulate(data.data(), data.size());
+	KT_CHECK(matches(hist, data));
+	KT_CHECK(hist.count(linear_e::c) == 128 && hist.count(linear_e::h) == 128);
+	return true;
+}
+
+bool check_parallel() {
+	auto const data = make_data<std::uint32_t>(50'000);
+	using hist_t = kt::flag_histogram<kt::uint_flags<std::uint32_t>>;
+	for (std::size_t const shards : {std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{8}}) {
+		KT_CHECK(matches(hist_t::parallel(data.data(), data.size(), shards), data));
+		KT_CHECK(matches(hist_t::parallel(data.data(), data.size(), shards, serial_executor{}), data));
+	}
+	// fewer values than one shard's minimum
+	KT_CHECK(matches(hist_t::parallel(data.data(), 100, 4), std::vector<kt::uint_flags<std::uint32_t>>(data.begin(), data.begin() + 100)));
+	return true;
+}
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_accumulate<std::uint8_t>),
+		KT_RUN_CHECK(check_accumulate<std::uint32_t>),
+		KT_RUN_CHECK(check_accumulate<std::uint64_t>),
+		KT_RUN_CHECK(check_flush),
+		KT_RUN_CHECK(check_merge),
+		KT_RUN_CHECK(check_enum_count),
+		KT_RUN_CHECK(check_parallel),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <vector>
+#include "enum_flags.hpp"
+#include "flag_index.hpp"
+#include "test.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, eCOUNT_ };
+
+using flags_t = kt::enum_flags<linear_e, std::uint8_t>;
+using index_t = kt::flag_index<flags_t>;
+
+std::vector<flags_t> make_rows(std::size_t count) {
+	std::vector<flags_t> ret(count);
+	std::uint32_t state = 0x12345678u;
+	for (auto& row : ret) {
+		state = state * 1664525u + 1013904223u;
+		row = flags_t::from_value(static_cast<std::uint8_t>((state >> 24) & 0x3f));
+	}
+	return ret;
+}
+
+// naive reference: linear scan with the predicate
+std::vector<std::size_t> scan(std::vector<flags_t> const& rows, kt::flag_predicate<flags_t> const& pred) {
+	std::vector<std::size_t> ret;
+	for (std::size_t i = 0; i < rows.size(); ++i) {
+		if (pred(rows[i])) { ret.push_back(i); }
+	}
+	return ret;
+}
+
+bool check_bitmaps() {
+	static_assert(index_t::bit_count_v == 6);
+	auto const rows = make_rows(130);
+	index_t index;
+	index.append(rows.data(), rows.size());
+	KT_CHECK(index.size() == rows.size());
+	for (std::size_t bit = 0; bit < index_t::bit_count_v; ++bit) {
+		auto const& bitmap = index.bitmap(bit);
+		KT_CHECK(bitmap.size() == 3);
+		for (std::size_t row = 0; row < rows.size(); ++row) {
+			bool const set = (bitmap[row / 64] >> (row % 64)) & 1;
+			KT_CHECK(set == rows[row].test(static_cast<linear_e>(bit)));
+		}
+	}
+	index.clear();
+	KT_CHECK(index.size() == 0 && index.bitmap(0).empty());
+	return true;
+}
+
+bool check_queries() {
+	// row counts around word boundaries
+	for (std::size_t const size : {std::size_t{0}, std::size_t{1}, std::size_t{63}, std::size_t{64}, std::size_t{65}, std::size_t{200}}) {
+		auto const rows = make_rows(size);
+		index_t index;
+		for (auto const row : rows) { index.push_back(row); }
+		kt::flag_predicate<flags_t> const preds[] = {
+			{},
+			kt::flag_predicate<flags_t>{}.all(linear_e::a),
+			kt::flag_predicate<flags_t>{}.all(linear_e::a, linear_e::c).none(linear_e::f),
+			kt::flag_predicate<flags_t>{}.none(linear_e::b, linear_e::d),
+			kt::flag_predicate<flags_t>{}.any(linear_e::b, linear_e::e).none(linear_e::a),
+		};
+		for (auto const& pred : preds) {
+			auto const expected = scan(rows, pred);
+			KT_CHECK(index.count(pred) == expected.size());
+			KT_CHECK(index.select(pred) == expected);
+			KT_CHECK(index.count(pred.all_of, pred.none_of) == scan(rows, {pred.all_of, pred.none_of, {}}).size());
+		}
+		// a bit beyond eCOUNT_ matches no row
+		KT_CHECK(index.count(flags_t::from_value(0x80)) == 0);
+	}
+	return true;
+}
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_bitmaps),
+		KT_RUN_CHECK(check_queries),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,130 @@
+#include <cstdint>
+#include <vector>
+#include "enum_flags.hpp"
+#include "flag_pipeline.hpp"
+#include "flag_remap.hpp"
+#include "test.hpp"
+
+namespace {
+enum class src_e { b0, b1, b2, b3, b4, b5, b6, b7, eCOUNT_ };
+enum class dst_e { b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, eCOUNT_ };
+
+using src_flags = kt::enum_flags<src_e, std::uint16_t>;
+using dst_flags = kt::enum_flags<dst_e, std::uint32_t>;
+using remap_t = kt::flag_remap<src_flags, dst_flags, kt::remap_pair<src_e::b0, dst_e::b2>, kt::remap_pair<src_e::b1, dst_e::b3>,
+							   kt::remap_pair<src_e::b4, dst_e::b9>, kt::remap_pair<src_e::b7, dst_e::b0>>;
+
+template <typename EF>
+struct collect_sink {
+	std::vector<EF>* out;
+
+	template <typename Out>
+	void push(EF const* data, std::size_t count, Out&&) {
+		out->insert(out->end(), data, data + count);
+	}
+	template <typename Out>
+	bool finish(Out&&) noexcept {
+		return true;
+	}
+};
+
+std::vector<src_flags> make_rows(std::size_t count) {
+	std::vector<src_flags> ret(count);
+	std::uint32_t state = 0x6d2b'79f5u;
+	for (auto& row : ret) {
+		state = state * 1664525u + 1013904223u;
+		row = src_flags::from_value(static_cast<std::uint16_t>(state >> 16));
+	}
+	return ret;
+}
+
+std::vector<std::uint8_t> encode(std::vector<src_flags> const& rows) {
+	std::vector<std::uint8_t> ret(rows.size() * kt::raw_size_v<src_flags>);
+	kt::encode_raw(rows.data(), rows.size(), ret.data(), ret.size());
+	return ret;
+}
+
+auto const pred_v = kt::flag_predicate<dst_flags>{}.any(dst_e::b2, dst_e::b9).none(dst_e::b0);
+
+bool check_remap_stage() {
+	auto const rows = make_rows(100);
+	std::vector<dst_flags> out;
+	// chunk smaller than a push: forwarded in several chunks
+	auto pipeline = kt::pipe(kt::remap_stage<remap_t, 8>{}, collect_sink<dst_flags>{&out});
+	pipeline.push(rows.data(), 37);
+	pipeline.push(rows.data() + 37, rows.size() - 37);
+	KT_CHECK(pipeline.finish() && out.size() == rows.size());
+	for (std::size_t i = 0; i < rows.size(); ++i) { KT_CHECK(out[i] == remap_t::apply(rows[i])); }
+	return true;
+}
+
+bool check_filter_stage() {
+	std::vector<dst_flags> rows;
+	for (std::uint32_t v = 0; v < 1024; ++v) { rows.push_back(dst_flags::from_value(v)); }
+	std::vector<dst_flags> expected;
+	for (auto const row : rows) {
+		if (pred_v(row)) { expected.push_back(row); }
+	}
+	for (std::size_t const push : {std::size_t{1}, std::size_t{5}, std::size_t{64}, rows.size()}) {
+		std::vector<dst_flags> out;
+		auto pipeline = kt::pipe(kt::filter_stage<dst_flags, 16>(pred_v), collect_sink<dst_flags>{&out});
+		for (std::size_t i = 0; i < rows.size(); i += push) { pipeline.push(rows.data() + i, rows.size() - i < push ? rows.size() - i : push); }
+		KT_CHECK(pipeline.finish() && out == expected);
+	}
+	return true;
+}
+
+bool check_histogram_sink() {
+	std::vector<dst_flags> rows;
+	for (std::uint32_t v = 0; v < 300; ++v) { rows.push_back(dst_flags::from_value(v * 7)); }
+	kt::flag_histogram<dst_flags> hist;
+	auto pipeline = kt::pipe(kt::histogram_sink<dst_flags>(hist));
+	pipeline.push(rows.data(), 100);
+	pipeline.push(rows.data() + 100, 200);
+	KT_CHECK(pipeline.finish() && hist.total() == rows.size());
+	for (std::size_t bit = 0; bit < 32; ++bit) {
+		std::uint64_t expected{};
+		for (auto const row : rows) { expected += (static_cast<std::uint32_t>(row) >> bit) & 1; }
+		KT_CHECK(hist[bit] == expected);
+	}
+	return true;
+}
+
+bool check_chain() {
+	// decode -> remap -> filter -> histogram, against the same steps applied row by row
+	auto const rows = make_rows(1000);
+	auto const bytes = encode(rows);
+	std::uint64_t expected[32]{};
+	std::uint64_t matched{};
+	for (auto const row : rows) {
+		auto const mapped = remap_t::apply(row);
+		if (!pred_v(mapped)) { continue; }
+		++matched;
+		for (std::size_t bit = 0; bit < 32; ++bit) { expected[bit] += (static_cast<std::uint32_t>(mapped) >> bit) & 1; }
+	}
+	for (std::size_t const split : {std::size_t{1}, std::size_t{3}, std::size_t{250}, bytes.size()}) {
+		kt::flag_histogram<dst_flags> hist;
+		auto pipeline = kt::pipe(kt::raw_decode_stage<src_flags, 32>{}, kt::remap_stage<remap_t, 16>{}, kt::filter_stage<dst_flags, 8>(pred_v),
+								 kt::histogram_sink<dst_flags>(hist));
+		for (std::size_t i = 0; i < bytes.size(); i += split) { pipeline.push(bytes.data() + i, bytes.size() - i < split ? bytes.size() - i : split); }
+		KT_CHECK(pipeline.finish() && hist.total() == matched);
+		for (std::size_t bit = 0; bit < 32; ++bit) { KT_CHECK(hist[bit] == expected[bit]); }
+	}
+	// a truncated record fails finish()
+	kt::flag_histogram<dst_flags> hist;
+	auto pipeline = kt::pipe(kt::raw_decode_stage<src_flags>{}, kt::remap_stage<remap_t>{}, kt::histogram_sink<dst_flags>(hist));
+	pipeline.push(bytes.data(), 5);
+	KT_CHECK(!pipeline.finish() && hist.total() == 2);
+	return true;
+}
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_remap_stage),
+		KT_RUN_CHECK(check_filter_stage),
+		KT_RUN_CHECK(check_histogram_sink),
+		KT_RUN_CHECK(check_chain),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <vector>
+#include "enum_flags.hpp"
+#include "flag_query.hpp"
+#include "test.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+
+using flags_t = kt::enum_flags<linear_e, std::uint16_t>;
+
+constexpr bool check_predicate() {
+	auto pred = kt::flag_predicate<flags_t>{}.all(linear_e::a).none(linear_e::h).any(linear_e::b, linear_e::c);
+	KT_CHECK(pred(flags_t::make(linear_e::a, linear_e::c)));
+	KT_CHECK(!pred(flags_t(linear_e::a)));
+	KT_CHECK(!pred(flags_t::make(linear_e::a, linear_e::b, linear_e::h)));
+	KT_CHECK(kt::flag_predicate<flags_t>{}(flags_t{}));
+	return true;
+}
+
+bool check_backends() {
+	std::vector<flags_t> data(200);
+	for (std::size_t i = 0; i < data.size(); ++i) { data[i] = flags_t::from_value(static_cast<std::uint16_t>(i)); }
+	auto const pred = kt::flag_predicate<flags_t>{}.all(linear_e::a).none(linear_e::c);
+	std::size_t expected{};
+	std::vector<std::uint64_t> bitmap((data.size() + 63) / 64);
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		if ((i & 5) == 1) {
+			++expected;
+			bitmap[i / 64] |= std::uint64_t{1} << (i % 64);
+		}
+	}
+	for (auto const backend : {kt::query_backend::scalar, kt::query_backend::parallel, kt::query_backend::simd}) {
+		KT_CHECK(kt::query_count(data.data(), data.size(), pred, backend) == expected);
+		std::vector<std::uint64_t> out;
+		kt::query_select(data.data(), data.size(), pred, out, backend);
+		KT_CHECK(out == bitmap);
+	}
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_predicate);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_predicate),
+		KT_RUN_CHECK(check_backends),
+	};
+	return kt::test::run_checks(checks);
+}
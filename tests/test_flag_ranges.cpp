@@ -0,0 +1,107 @@
+#include <cstdint>
+#include "enum_flags.hpp"
+#include "test.hpp"
+#include "uint_flags.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, eCOUNT_ };
+enum class pot_e : std::uint8_t { a = 1, b = 2, c = 4, eCOUNT_ = 8 };
+
+using flags_t = kt::enum_flags<linear_e, std::uint8_t>;
+using pot_flags = kt::enum_flags<pot_e, std::uint8_t, kt::enum_trait_pot>;
+using uflags = kt::uint_flags<std::uint8_t>;
+
+constexpr std::size_t choose(std::size_t n, std::size_t k) {
+	if (k > n) { return 0; }
+	std::size_t ret = 1;
+	for (std::size_t i = 0; i < k; ++i) { ret = ret * (n - i) / (i + 1); }
+	return ret;
+}
+
+constexpr bool check_subsets() {
+	for (unsigned mask = 0; mask < 0x80; mask += 0x0b) {
+		auto const flags = flags_t::from_value(static_cast<std::uint8_t>(mask));
+		// naive reference: every value with no bits outside mask, visited in descending order
+		unsigned expected = 0x100;
+		std::size_t count{};
+		for (auto const s : flags.subsets()) {
+			auto const value = static_cast<unsigned>(static_cast<std::uint8_t>(s));
+			KT_CHECK((value & ~mask) == 0 && value < expected);
+			expected = value;
+			++count;
+		}
+		KT_CHECK(count == std::size_t{1} << flags.count() && expected == 0);
+	}
+	return true;
+}
+
+constexpr bool check_supersets() {
+	auto const universe = flags_t::make(linear_e::a, linear_e::b, linear_e::d, linear_e::f);
+	auto const base = flags_t::make(linear_e::b, linear_e::g);
+	std::size_t count{};
+	int previous = -1;
+	for (auto const s : base.supersets_within(universe)) {
+		auto const value = static_cast<int>(static_cast<std::uint8_t>(s));
+		// within universe, keeps base bits inside it, ascending
+		KT_CHECK(universe.all(s) && s.test(linear_e::b) && value > previous);
+		previous = value;
+		++count;
+	}
+	std::size_t naive{};
+	for (unsigned v = 0; v < 0x100; ++v) {
+		auto const s = flags_t::from_value(static_cast<std::uint8_t>(v));
+		naive += static_cast<std::size_t>(universe.all(s) && s.test(linear_e::b));
+	}
+	KT_CHECK(count == naive && count == 8);
+	return true;
+}
+
+template <typename EF>
+constexpr bool check_combinations_of(std::size_t n) {
+	for (std::size_t k = 0; k <= n; ++k) {
+		std::size_t count{};
+		for (auto const c : kt::combinations<EF>(k, n)) {
+			auto const value = static_cast<unsigned>(static_cast<typename EF::value_type>(c));
+			KT_CHECK(c.count() == k && (value >> n) == 0);
+			++count;
+		}
+		KT_CHECK(count == choose(n, k));
+	}
+	return true;
+}
+
+constexpr bool check_combinations() {
+	// default universe: enumerators of the layout
+	KT_CHECK(kt::flag_universe_v<flags_t> == 7 && kt::flag_universe_v<pot_flags> == 3 && kt::flag_universe_v<uflags> == 8);
+	KT_CHECK(check_combinations_of<flags_t>(kt::flag_universe_v<flags_t>));
+	KT_CHECK(check_combinations_of<flags_t>(4));
+	KT_CHECK(check_combinations_of<uflags>(8));
+	std::size_t count{};
+	for (auto const c : kt::combinations<flags_t>(3)) {
+		KT_CHECK(!c.test(linear_e::eCOUNT_));
+		++count;
+	}
+	KT_CHECK(count == choose(7, 3));
+	// pot: bit i is value 1 << i
+	count = 0;
+	for (auto const c : kt::combinations<pot_flags>(2)) { count += static_cast<std::size_t>(c.count() == 2); }
+	KT_CHECK(count == 3);
+	// beyond the universe or k > n: empty
+	KT_CHECK(kt::combinations<flags_t>(1, 8).empty() && kt::combinations<flags_t>(5, 4).empty());
+	KT_CHECK(!kt::combinations<flags_t>(0).empty() && *kt::combinations<flags_t>(0).begin() == flags_t{});
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_subsets);
+KT_CONSTEXPR_CHECK(check_supersets);
+KT_CONSTEXPR_CHECK(check_combinations);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_subsets),
+		KT_RUN_CHECK(check_supersets),
+		KT_RUN_CHECK(check_combinations),
+	};
+	return kt::test::run_checks(checks);
+}
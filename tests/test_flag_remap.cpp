@@ -0,0 +1,77 @@
+#include <cstdint>
+#include "enum_flags.hpp"
+#include "flag_remap.hpp"
+#include "test.hpp"
+
+namespace {
+enum class src_e { b0, b1, b2, b3, b4, b5, b6, b7, eCOUNT_ };
+enum class dst_e { b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, eCOUNT_ };
+
+using src_flags = kt::enum_flags<src_e, std::uint64_t>;
+using dst_flags = kt::enum_flags<dst_e, std::uint64_t>;
+
+template <typename Remap>
+constexpr std::uint64_t remap(std::uint64_t bits) {
+	return static_cast<std::uint64_t>(Remap::apply(src_flags::from_value(bits)));
+}
+
+// strictly increasing sources and targets, four distinct shifts (pext / pdep path with BMI2)
+using ordered_t = kt::flag_remap<src_flags, dst_flags, kt::remap_pair<src_e::b0, dst_e::b1>, kt::remap_pair<src_e::b2, dst_e::b4>,
+								 kt::remap_pair<src_e::b5, dst_e::b8>, kt::remap_pair<src_e::b6, dst_e::b10>>;
+// one source to two targets
+using fan_out_t = kt::flag_remap<src_flags, dst_flags, kt::remap_pair<src_e::b0, dst_e::b0>, kt::remap_pair<src_e::b0, dst_e::b1>,
+								 kt::remap_pair<src_e::b2, dst_e::b4>, kt::remap_pair<src_e::b5, dst_e::b8>>;
+// two sources to one target
+using fan_in_t = kt::flag_remap<src_flags, dst_flags, kt::remap_pair<src_e::b0, dst_e::b3>, kt::remap_pair<src_e::b1, dst_e::b3>,
+								kt::remap_pair<src_e::b4, dst_e::b5>, kt::remap_pair<src_e::b6, dst_e::b9>>;
+// order reversing
+using reversed_t = kt::flag_remap<src_flags, dst_flags, kt::remap_pair<src_e::b0, dst_e::b7>, kt::remap_pair<src_e::b1, dst_e::b5>,
+								  kt::remap_pair<src_e::b2, dst_e::b2>, kt::remap_pair<src_e::b3, dst_e::b0>>;
+
+constexpr bool check_ordered() {
+	KT_CHECK(remap<ordered_t>(0x65) == 0x512);
+	KT_CHECK(remap<ordered_t>(0x04) == 0x10);
+	KT_CHECK(remap<ordered_t>(0x9a) == 0); // unmapped bits are dropped
+	return true;
+}
+
+constexpr bool check_fan_out() {
+	KT_CHECK(remap<fan_out_t>(0x25) == 0x113);
+	KT_CHECK(remap<fan_out_t>(0x01) == 0x3);
+	KT_CHECK(remap<fan_out_t>(0x20) == 0x100);
+	return true;
+}
+
+constexpr bool check_fan_in() {
+	KT_CHECK(remap<fan_in_t>(0x53) == 0x228);
+	KT_CHECK(remap<fan_in_t>(0x02) == 0x8);
+	KT_CHECK(remap<fan_in_t>(0x50) == 0x220);
+	return true;
+}
+
+constexpr bool check_reversed() {
+	KT_CHECK(remap<reversed_t>(0x0f) == 0xa5);
+	KT_CHECK(remap<reversed_t>(0x09) == 0x81);
+	return true;
+}
+
+bool check_batch() {
+	src_flags const in[] = {src_flags::from_value(0x25), src_flags::from_value(0x01), src_flags{}};
+	dst_flags out[3]{};
+	fan_out_t::apply(in, 3, out);
+	KT_CHECK(static_cast<std::uint64_t>(out[0]) == 0x113 && static_cast<std::uint64_t>(out[1]) == 0x3 && static_cast<std::uint64_t>(out[2]) == 0);
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_ordered);
+KT_CONSTEXPR_CHECK(check_fan_out);
+KT_CONSTEXPR_CHECK(check_fan_in);
+KT_CONSTEXPR_CHECK(check_reversed);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_ordered), KT_RUN_CHECK(check_fan_out), KT_RUN_CHECK(check_fan_in), KT_RUN_CHECK(check_reversed), KT_RUN_CHECK(check_batch),
+	};
+	return kt::test::run_checks(checks);
+}
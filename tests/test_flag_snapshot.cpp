@@ -0,0 +1,110 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include "enum_flags.hpp"
+#include "flag_snapshot.hpp"
+#include "test.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+enum class big_e { e0, e64 = 64, e150 = 150, eCOUNT_ };
+
+using flags_t = kt::enum_flags<linear_e, std::uint32_t>;
+using wide_t = kt::wide_flags<big_e>;
+
+// every word equal: a torn read shows up as differing words
+wide_t pattern(std::uint64_t value) {
+	typename wide_t::storage_t bits;
+	for (auto& word : bits.words) { word = value; }
+	return wide_t::from_value(bits);
+}
+bool is_pattern(wide_t flags) {
+	auto const bits = static_cast<typename wide_t::storage_t>(flags);
+	for (auto const word : bits.words) {
+		if (word != bits.words[0]) { return false; }
+	}
+	return true;
+}
+
+bool check_single() {
+	kt::flag_snapshot<flags_t> snapshot(flags_t(linear_e::a));
+	KT_CHECK(snapshot.load() == flags_t(linear_e::a) && snapshot.version() == 0);
+	snapshot.store(flags_t::make(linear_e::b, linear_e::c));
+	KT_CHECK(snapshot.load() == flags_t::make(linear_e::b, linear_e::c) && snapshot.version() == 1);
+	auto const previous = snapshot.update(flags_t(linear_e::h), flags_t(linear_e::b));
+	KT_CHECK(previous == flags_t::make(linear_e::b, linear_e::c) && snapshot.load() == flags_t::make(linear_e::c, linear_e::h));
+	KT_CHECK(snapshot.version() == 2);
+	KT_CHECK(snapshot.changed(flags_t(linear_e::h), previous) && !snapshot.changed(flags_t(linear_e::c), previous));
+	// already differs: returns without blocking
+	KT_CHECK(snapshot.wait(flags_t(linear_e::b), previous) == snapshot.load());
+	return true;
+}
+
+bool check_wide() {
+	static_assert(sizeof(wide_t::storage_t) == 24);
+	kt::flag_snapshot<wide_t> snapshot;
+	KT_CHECK(snapshot.load() == wide_t{});
+	snapshot.store(wide_t::make(big_e::e0, big_e::e150));
+	KT_CHECK(snapshot.load() == wide_t::make(big_e::e0, big_e::e150));
+	auto const previous = snapshot.update(wide_t(big_e::e64), wide_t(big_e::e0));
+	KT_CHECK(previous == wide_t::make(big_e::e0, big_e::e150) && snapshot.load() == wide_t::make(big_e::e64, big_e::e150));
+	KT_CHECK(snapshot.version() == 2);
+	return true;
+}
+
+bool check_torn_reads() {
+	kt::flag_snapshot<wide_t> snapshot(pattern(0));
+	std::atomic<bool> done{};
+	std::atomic<bool> torn{};
+	std::thread reader([&] {
+		while (!done.load(std::memory_order_acquire)) {
+			if (!is_pattern(snapshot.load())) { torn.store(true); }
+		}
+	});
+	for (std::uint64_t i = 1; i <= 20'000; ++i) { snapshot.store(pattern(i * 0x0101'0101'0101'0101ull)); }
+	done.store(true, std::memory_order_release);
+	reader.join();
+	KT_CHECK(!torn.load() && snapshot.version() == 20'000);
+	return true;
+}
+
+bool check_concurrent_updates() {
+	kt::flag_snapshot<flags_t> snapshot;
+	// each writer toggles its own bit on and off; updates must never be lost
+	auto const writer = [&snapshot](linear_e bit) {
+		for (int i = 0; i < 2'000; ++i) {
+			snapshot.update(flags_t(bit));
+			snapshot.update({}, flags_t(bit));
+		}
+		snapshot.update(flags_t(bit));
+	};
+	std::thread a(writer, linear_e::a), b(writer, linear_e::d);
+	a.join();
+	b.join();
+	KT_CHECK(snapshot.load() == flags_t::make(linear_e::a, linear_e::d) && snapshot.version() == 2 * 4'001);
+	return true;
+}
+
+bool check_wait() {
+	kt::flag_snapshot<flags_t> snapshot;
+	auto const previous = snapshot.load();
+	std::thread waiter([&] {
+		auto const observed = snapshot.wait(flags_t(linear_e::e), previous);
+		if (!observed.test(linear_e::e)) { std::abort(); }
+	});
+	// changes outside the mask do not wake the waiter for good
+	snapshot.update(flags_t(linear_e::a));
+	snapshot.update(flags_t(linear_e::e));
+	waiter.join();
+	KT_CHECK(snapshot.load() == flags_t::make(linear_e::a, linear_e::e));
+	return true;
+}
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_single), KT_RUN_CHECK(check_wide), KT_RUN_CHECK(check_torn_reads), KT_RUN_CHECK(check_concurrent_updates), KT_RUN_CHECK(check_wait),
+	};
+	return kt::test::run_checks(checks);
+}
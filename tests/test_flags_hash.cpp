@@ -0,0 +1,68 @@
+#include <cstdint>
+#include <functional>
+#include "flags_hash.hpp"
+#include "test.hpp"
+
+namespace {
+enum class perm_e { read, write, exec, admin, eCOUNT_ };
+using perm_flags = kt::enum_flags<perm_e, std::uint8_t>;
+using key_flags = kt::uint_flags<std::uint32_t>;
+
+constexpr bool check_hash() {
+	std::hash<perm_flags> const hasher{};
+	// single bit keys must not collide in the low bits used for slots
+	KT_CHECK((hasher(perm_flags(perm_e::read)) & 0xff) != (hasher(perm_flags(perm_e::write)) & 0xff));
+	KT_CHECK(hasher(perm_flags::make(perm_e::read)) == kt::hash_flags(std::uint8_t{1}));
+	KT_CHECK(std::hash<key_flags>{}(key_flags::from_value(0x10)) == kt::hash_flags(std::uint32_t{0x10}));
+	KT_CHECK(kt::hash_mix(0) == 0 && kt::hash_mix(1) != 1);
+	return true;
+}
+
+bool check_map() {
+	kt::flags_map<key_flags, int> map;
+	KT_CHECK(map.empty() && map.find(key_flags::from_value(1)) == nullptr);
+	for (std::uint32_t i = 0; i < 100; ++i) { KT_CHECK(map.insert(key_flags::from_value(i), static_cast<int>(i)).second); }
+	KT_CHECK(map.size() == 100);
+	for (std::uint32_t i = 0; i < 100; ++i) {
+		auto const* value = map.find(key_flags::from_value(i));
+		KT_CHECK(value && *value == static_cast<int>(i));
+	}
+	KT_CHECK(!map.insert(key_flags::from_value(5), 0).second && *map.find(key_flags::from_value(5)) == 5);
+	map[key_flags::from_value(200)] = 7;
+	KT_CHECK(map.size() == 101 && *map.find(key_flags::from_value(200)) == 7);
+	for (std::uint32_t i = 0; i < 100; i += 2) { KT_CHECK(map.erase(key_flags::from_value(i))); }
+	KT_CHECK(!map.erase(key_flags::from_value(0)) && map.size() == 51);
+	for (std::uint32_t i = 0; i < 100; ++i) { KT_CHECK(map.contains(key_flags::from_value(i)) == (i % 2 == 1)); }
+	std::size_t visited{};
+	map.for_each([&visited](key_flags, int&) { ++visited; });
+	KT_CHECK(visited == 51);
+	map.clear();
+	KT_CHECK(map.empty() && !map.contains(key_flags::from_value(1)));
+	return true;
+}
+
+bool check_insert_existing_does_not_rehash() {
+	kt::flags_map<perm_flags, int> map;
+	// 6 entries fill 8 slots to the 3/4 load factor: one more new key would rehash
+	for (std::uint8_t i = 0; i < 6; ++i) { map.insert(perm_flags::from_value(i), i); }
+	auto const* before = map.find(perm_flags::from_value(3));
+	KT_CHECK(!map.insert(perm_flags::from_value(3), 0).second);
+	KT_CHECK(!map.insert(perm_flags::from_value(0), 0).second);
+	map[perm_flags::from_value(5)] = 50;
+	// pointers are invalidated only by rehash
+	KT_CHECK(map.find(perm_flags::from_value(3)) == before && *map.find(perm_flags::from_value(5)) == 50);
+	KT_CHECK(map.insert(perm_flags::from_value(6), 6).second && map.size() == 7);
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_hash);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_hash),
+		KT_RUN_CHECK(check_map),
+		KT_RUN_CHECK(check_insert_existing_does_not_rehash),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,69 @@
+#include <cstdint>
+#include "enum_flags.hpp"
+#include "flags_table.hpp"
+#include "test.hpp"
+#include "uint_flags.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+
+using flags_t = kt::enum_flags<linear_e, std::uint8_t>;
+using wide_t = kt::uint_flags<std::uint32_t>;
+
+constexpr std::uint32_t sparse_mask_v = 0x8001'0005u;
+
+constexpr std::size_t score(flags_t flags) { return flags.count() * 10 + (flags.test(linear_e::h) ? 1 : 0); }
+constexpr std::uint32_t echo(wide_t flags) { return flags.bits; }
+
+constexpr bool check_dense() {
+	constexpr auto table = kt::flags_table<flags_t, std::size_t>::generate(&score);
+	static_assert(decltype(table)::size_v == 256);
+	for (unsigned v = 0; v < 256; ++v) {
+		auto const flags = flags_t::from_value(static_cast<std::uint8_t>(v));
+		KT_CHECK(table[flags] == score(flags));
+	}
+	auto copy = table;
+	copy[flags_t(linear_e::c)] = 7;
+	KT_CHECK(copy[flags_t(linear_e::c)] == 7 && copy[flags_t(linear_e::d)] == score(flags_t(linear_e::d)));
+	return true;
+}
+
+constexpr bool check_sparse() {
+	using table_t = kt::sparse_flags_table<wide_t, std::uint32_t, sparse_mask_v>;
+	static_assert(table_t::size_v == 16);
+	constexpr auto table = table_t::generate(&echo);
+	// bits outside the mask are ignored: the entry is gen(flags & Mask)
+	std::uint32_t value = 0x9e37'79b9u;
+	for (int i = 0; i < 200; ++i) {
+		value = value * 1664525u + 1013904223u;
+		KT_CHECK(table[wide_t::from_value(value)] == (value & sparse_mask_v));
+	}
+	KT_CHECK(table[wide_t::from_value(sparse_mask_v)] == sparse_mask_v && table[wide_t::from_value(~sparse_mask_v)] == 0);
+	auto copy = table;
+	copy[wide_t::from_value(0x4u)] = 42;
+	KT_CHECK(copy[wide_t::from_value(0x4u | 0x2u)] == 42);
+	return true;
+}
+
+bool check_dense_16() {
+	using table_t = kt::flags_table<kt::uint_flags<std::uint16_t>, std::uint8_t>;
+	static auto const table = table_t::generate([](kt::uint_flags<std::uint16_t> flags) { return static_cast<std::uint8_t>(flags.count()); });
+	for (std::uint32_t v = 0; v < table_t::size_v; v += 97) {
+		auto const flags = kt::uint_flags<std::uint16_t>::from_value(static_cast<std::uint16_t>(v));
+		KT_CHECK(table[flags] == flags.count());
+	}
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_dense);
+KT_CONSTEXPR_CHECK(check_sparse);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_dense),
+		KT_RUN_CHECK(check_sparse),
+		KT_RUN_CHECK(check_dense_16),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "mapped_flag_column.hpp"
+#include "test.hpp"
+
+namespace {
+namespace v1 {
+enum class perm_e { read, write, exec, eCOUNT_ };
+}
+namespace v2 {
+enum class perm_e { exec, read, write, eCOUNT_ };
+}
+namespace v3 {
+enum class perm_e { read, write, run, eCOUNT_ };
+}
+namespace v4 {
+enum class perm_e { read, write, exec, eCOUNT_ };
+}
+} // namespace
+
+template <>
+struct kt::flag_column_version<v4::perm_e> : std::integral_constant<std::uint32_t, 1> {};
+
+namespace {
+template <typename Enum>
+using column_t = kt::mapped_flag_column<Enum, std::uint8_t>;
+
+template <typename Enum>
+constexpr std::uint64_t layout_hash_v = column_t<Enum>::make_header(0).layout_hash;
+
+constexpr bool check_layout_hash() {
+	KT_CHECK(layout_hash_v<v1::perm_e> != layout_hash_v<v2::perm_e>); // reordered
+	KT_CHECK(layout_hash_v<v1::perm_e> != layout_hash_v<v3::perm_e>); // renamed
+	KT_CHECK(layout_hash_v<v1::perm_e> != layout_hash_v<v4::perm_e>); // version bumped
+	KT_CHECK(column_t<v1::perm_e>::is_compatible(column_t<v1::perm_e>::make_header(4)));
+	KT_CHECK(!column_t<v1::perm_e>::is_compatible(column_t<v2::perm_e>::make_header(4)));
+	KT_CHECK(!column_t<v1::perm_e>::is_compatible(kt::mapped_flag_column<v1::perm_e, std::uint16_t>::make_header(4)));
+	return true;
+}
+
+std::vector<unsigned char> make_image(typename column_t<v1::perm_e>::flags_t const* data, std::size_t count) {
+	std::vector<unsigned char> ret(kt::flag_column_header::data_offset_v + count);
+	auto const header = column_t<v1::perm_e>::make_header(count);
+	std::memcpy(ret.data(), &header, sizeof(header));
+	std::memcpy(ret.data() + kt::flag_column_header::data_offset_v, data, count);
+	return ret;
+}
+
+bool check_view() {
+	using flags_t = column_t<v1::perm_e>::flags_t;
+	flags_t const data[] = {flags_t(v1::perm_e::read), flags_t::make(v1::perm_e::write, v1::perm_e::exec), flags_t{}};
+	auto const image = make_image(data, 3);
+	auto const view = column_t<v1::perm_e>::view(image.data(), image.size());
+	KT_CHECK(view && view.size() == 3 && view[1] == data[1]);
+	KT_CHECK(!column_t<v2::perm_e>::view(image.data(), image.size()));
+	KT_CHECK(!column_t<v1::perm_e>::view(image.data(), image.size() - 1)); // truncated
+	return true;
+}
+
+bool check_file() {
+	using flags_t = column_t<v1::perm_e>::flags_t;
+	flags_t const data[] = {flags_t(v1::perm_e::exec), flags_t::make(v1::perm_e::read, v1::perm_e::write)};
+	char const* path = "test_mapped_flag_column.bin"; // working directory (build tree under ctest)
+	KT_CHECK(column_t<v1::perm_e>::write(path, data, 2));
+	column_t<v1::perm_e> column;
+	bool const opened = column.open(path);
+#if defined(__unix__) || defined(__APPLE__)
+	KT_CHECK(opened && column.size() == 2 && column[0] == data[0] && column[1] == data[1]);
+	column_t<v2::perm_e> reordered;
+	KT_CHECK(!reordered.open(path));
+#else
+	KT_CHECK(!opened);
+#endif
+	column.close();
+	std::remove(path);
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_layout_hash);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_layout_hash),
+		KT_RUN_CHECK(check_view),
+		KT_RUN_CHECK(check_file),
+	};
+	return kt::test::run_checks(checks);
+}
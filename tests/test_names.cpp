@@ -0,0 +1,92 @@
+#include <string_view>
+#include "enum_flags.hpp"
+#include "flag_names.hpp"
+#include "test.hpp"
+
+namespace {
+enum class perm_e { read, write, exec, admin, eCOUNT_ };
+using perm_flags = kt::enum_flags<perm_e, std::uint8_t>;
+
+constexpr kt::flag_names<4> names_v({"read", "write", "exec", "admin"});
+
+constexpr bool parses(std::string_view str, perm_flags expected) {
+	perm_flags out{};
+	auto const [ptr, ec] = kt::from_chars(str.data(), str.data() + str.size(), out, names_v);
+	return ec == std::errc{} && ptr == str.data() + str.size() && out == expected;
+}
+
+constexpr bool rejects(std::string_view str, std::size_t error_at) {
+	perm_flags out = perm_flags(perm_e::admin);
+	auto const [ptr, ec] = kt::from_chars(str.data(), str.data() + str.size(), out, names_v);
+	// out is untouched on failure
+	return ec == std::errc::invalid_argument && ptr == str.data() + error_at && out == perm_flags(perm_e::admin);
+}
+
+constexpr bool check_find() {
+	KT_CHECK(names_v.find("read") == 0 && names_v.find("admin") == 3);
+	KT_CHECK(names_v.find("") == kt::flag_names<4>::npos && names_v.find("reads") == kt::flag_names<4>::npos);
+	KT_CHECK(names_v[2] == "exec" && names_v[4].empty());
+	return true;
+}
+
+constexpr bool check_format() {
+	char buf[32]{};
+	auto const flags = perm_flags::make(perm_e::read, perm_e::exec, perm_e::admin);
+	auto const res = kt::format_flags(flags, names_v, buf, sizeof(buf));
+	KT_CHECK(res.ec == std::errc{} && std::string_view(buf, static_cast<std::size_t>(res.ptr - buf)) == "read|exec|admin" && *res.ptr == '\0');
+	// no flags set succeeds with an empty string
+	auto const none = kt::format_flags(perm_flags{}, names_v, buf, sizeof(buf));
+	KT_CHECK(none.ec == std::errc{} && none.ptr == buf && buf[0] == '\0');
+	KT_CHECK(kt::format_flags(perm_flags{}, names_v, buf, 1).ec == std::errc{});
+	// "read|exec|admin" needs 16 bytes including the terminator
+	auto const small = kt::format_flags(flags, names_v, buf, 15);
+	KT_CHECK(small.ec == std::errc::value_too_large && small.ptr == buf && buf[0] == '\0');
+	KT_CHECK(kt::format_flags(flags, names_v, buf, 16).ec == std::errc{});
+	KT_CHECK(kt::format_flags(perm_flags{}, names_v, buf, 0).ec == std::errc::value_too_large);
+	auto const [ptr, ec] = kt::to_chars(buf, buf + 4, flags, names_v, ',');
+	KT_CHECK(ec == std::errc::value_too_large && ptr == buf + 4);
+	return true;
+}
+
+constexpr bool check_parse() {
+	KT_CHECK(parses("", perm_flags{}));
+	KT_CHECK(parses("write", perm_flags(perm_e::write)));
+	KT_CHECK(parses("read|exec|admin", perm_flags::make(perm_e::read, perm_e::exec, perm_e::admin)));
+	KT_CHECK(parses("admin|read", perm_flags::make(perm_e::read, perm_e::admin)));
+	KT_CHECK(rejects("rwx", 0));
+	KT_CHECK(rejects("read|bogus", 5));
+	return true;
+}
+
+constexpr bool check_empty_tokens() {
+	KT_CHECK(rejects("|", 0));
+	KT_CHECK(rejects("|read", 0));
+	KT_CHECK(rejects("read|", 5));
+	KT_CHECK(rejects("read||write", 5));
+	KT_CHECK(rejects("read|write||", 11));
+	return true;
+}
+
+constexpr bool check_round_trip() {
+	for (std::uint8_t value = 0; value < 16; ++value) {
+		char buf[32]{};
+		auto const flags = perm_flags::from_value(value);
+		auto const [ptr, ec] = kt::format_flags(flags, names_v, buf, sizeof(buf));
+		KT_CHECK(ec == std::errc{} && parses(std::string_view(buf, static_cast<std::size_t>(ptr - buf)), flags));
+	}
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_find);
+KT_CONSTEXPR_CHECK(check_format);
+KT_CONSTEXPR_CHECK(check_parse);
+KT_CONSTEXPR_CHECK(check_empty_tokens);
+KT_CONSTEXPR_CHECK(check_round_trip);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_find), KT_RUN_CHECK(check_format), KT_RUN_CHECK(check_parse), KT_RUN_CHECK(check_empty_tokens), KT_RUN_CHECK(check_round_trip),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <type_traits>
+#include "packed_fields.hpp"
+#include "test.hpp"
+
+namespace {
+enum class state_e : std::uint8_t { idle, walk, run, jump, fall, eCOUNT_ };
+enum class team_e { red, blue, green };
+enum class caps_e { fly, swim, climb, eCOUNT_ };
+
+using caps_flags = kt::enum_flags<caps_e, std::uint32_t>;
+using header_t = kt::packed_fields<std::uint32_t, kt::bit_field<state_e, 3>, kt::bit_field<team_e, 2>, kt::flags_field<caps_e>, kt::bit_field<int, 5>,
+								   kt::bit_field<bool, 1>>;
+
+static_assert(sizeof(header_t) == sizeof(std::uint32_t) && std::is_trivial_v<header_t>);
+static_assert(header_t::size_v == 5 && header_t::bits_v == 14);
+static_assert(std::is_same_v<header_t::value_t<2>, caps_flags>);
+
+// naive reference: hand-written shifts
+constexpr std::uint32_t pack(unsigned state, unsigned team, unsigned caps, int layer, bool active) {
+	return state | team << 3 | caps << 5 | (static_cast<std::uint32_t>(layer) & 0x1f) << 8 | static_cast<std::uint32_t>(active) << 13;
+}
+
+constexpr bool check_layout() {
+	KT_CHECK(header_t::offset<0>() == 0 && header_t::offset<1>() == 3 && header_t::offset<2>() == 5 && header_t::offset<3>() == 8 && header_t::offset<4>() == 13);
+	KT_CHECK(header_t::mask<0>() == 0x7 && header_t::mask<1>() == 0x18 && header_t::mask<2>() == 0xe0 && header_t::mask<3>() == 0x1f00);
+	KT_CHECK(header_t::mask<4>() == 0x2000);
+	// all masks are disjoint and cover bits_v
+	KT_CHECK((header_t::mask<0>() | header_t::mask<1>() | header_t::mask<2>() | header_t::mask<3>() | header_t::mask<4>()) == (1u << header_t::bits_v) - 1);
+	return true;
+}
+
+constexpr bool check_get_set() {
+	header_t h{};
+	h.set<0>(state_e::jump).set<1>(team_e::green).set<2>(caps_flags::make(caps_e::fly, caps_e::climb)).set<3>(-7).set<4>(true);
+	KT_CHECK(h.bits.bits == pack(3, 2, 0x5, -7, true));
+	KT_CHECK(h.get<0>() == state_e::jump && h.get<1>() == team_e::green && h.get<3>() == -7 && h.get<4>());
+	KT_CHECK(h.get<2>() == caps_flags::make(caps_e::fly, caps_e::climb));
+	// each set touches only its own field
+	h.set<1>(team_e::blue);
+	KT_CHECK(h.bits.bits == pack(3, 1, 0x5, -7, true));
+	h.set<3>(15);
+	KT_CHECK(h.get<3>() == 15 && h.get<0>() == state_e::jump && h.get<4>());
+	h.set<3>(-16);
+	KT_CHECK(h.get<3>() == -16 && h.bits.bits == pack(3, 1, 0x5, -16, true));
+	h.set<4>(false);
+	KT_CHECK(!h.get<4>() && h.bits.bits == pack(3, 1, 0x5, -16, false));
+	return true;
+}
+
+constexpr bool check_excess_bits() {
+	header_t h{};
+	// excess bits are dropped, neighbours are untouched
+	h.set<1>(static_cast<team_e>(7));
+	KT_CHECK(h.get<1>() == static_cast<team_e>(3) && h.get<0>() == state_e::idle && h.get<2>() == caps_flags{});
+	h.set<3>(0x3f);
+	KT_CHECK(h.get<3>() == -1 && !h.get<4>());
+	return true;
+}
+
+constexpr bool check_round_trip() {
+	for (unsigned state = 0; state < 5; ++state) {
+		for (int layer = -16; layer < 16; layer += 5) {
+			header_t h{};
+			h.set<3>(layer).set<0>(static_cast<state_e>(state)).set<2>(caps_flags(caps_e::swim));
+			KT_CHECK(h.bits.bits == pack(state, 0, 0x2, layer, false));
+			KT_CHECK(h.get<0>() == static_cast<state_e>(state) && h.get<3>() == layer && h.get<2>() == caps_flags(caps_e::swim));
+		}
+	}
+	return true;
+}
+
+constexpr bool check_flags_ref() {
+	header_t h{};
+	h.set<0>(state_e::fall).set<3>(-1).set<4>(true);
+	auto caps = h.flags<2>();
+	caps.set(caps_e::fly, caps_e::swim);
+	KT_CHECK(h.get<2>() == caps_flags::make(caps_e::fly, caps_e::swim) && caps.test(caps_e::swim) && caps.count() == 2);
+	caps.reset(caps_e::fly).flip(caps_e::climb);
+	KT_CHECK(h.bits.bits == pack(4, 0, 0x6, -1, true));
+	caps.update(caps_flags(caps_e::fly), caps_flags(caps_e::swim));
+	KT_CHECK(h.bits.bits == pack(4, 0, 0x5, -1, true));
+	caps &= caps_flags::make(caps_e::climb, caps_e::swim);
+	KT_CHECK(h.bits.bits == pack(4, 0, 0x4, -1, true) && caps.all(caps_flags(caps_e::climb)) && !caps.any(caps_flags(caps_e::fly)));
+	caps |= caps_flags(caps_e::fly);
+	caps ^= caps_flags(caps_e::climb);
+	KT_CHECK(static_cast<caps_flags>(caps) == caps_flags(caps_e::fly));
+	caps = caps_flags::make(caps_e::swim, caps_e::climb);
+	// neighbours are never touched
+	KT_CHECK(h.bits.bits == pack(4, 0, 0x6, -1, true) && h.get<0>() == state_e::fall && h.get<3>() == -1 && h.get<4>());
+	// assigning a reference copies the value, it does not rebind
+	header_t other{};
+	other.flags<2>() = h.flags<2>();
+	KT_CHECK(other.bits.bits == pack(0, 0, 0x6, 0, false));
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_layout);
+KT_CONSTEXPR_CHECK(check_get_set);
+KT_CONSTEXPR_CHECK(check_excess_bits);
+KT_CONSTEXPR_CHECK(check_round_trip);
+KT_CONSTEXPR_CHECK(check_flags_ref);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_layout),
+		KT_RUN_CHECK(check_get_set),
+		KT_RUN_CHECK(check_excess_bits),
+		KT_RUN_CHECK(check_round_trip),
+		KT_RUN_CHECK(check_flags_ref),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <vector>
+#include "enum_flags.hpp"
+#include "test.hpp"
+#include "tracked_flags.hpp"
+
+namespace {
+enum class linear_e { a, b, c, d, e, f, g, h, eCOUNT_ };
+
+using flags_t = kt::enum_flags<linear_e, std::uint8_t>;
+
+constexpr bool check_tracked() {
+	kt::tracked_flags<flags_t> f(flags_t(linear_e::a));
+	KT_CHECK(!f.has_changes() && f.get() == flags_t(linear_e::a));
+	f.set(linear_e::b, linear_e::c).reset(linear_e::a);
+	KT_CHECK(f.has_changes() && f.changed() == flags_t::make(linear_e::a, linear_e::b, linear_e::c));
+	auto const changes = f.take_changes();
+	KT_CHECK(changes.rising == flags_t::make(linear_e::b, linear_e::c) && changes.falling == flags_t(linear_e::a) && changes.any());
+	KT_CHECK(!f.has_changes() && !f.take_changes().any());
+	// toggled back: cancels out
+	f.set(linear_e::h).reset(linear_e::h);
+	KT_CHECK(!f.has_changes());
+	f.update(flags_t(linear_e::d), flags_t(linear_e::b));
+	f.assign(static_cast<flags_t const&>(f) | flags_t(linear_e::e));
+	auto const next = f.take_changes();
+	KT_CHECK(next.rising == flags_t::make(linear_e::d, linear_e::e) && next.falling == flags_t(linear_e::b));
+	KT_CHECK(f.get() == flags_t::make(linear_e::c, linear_e::d, linear_e::e));
+	return true;
+}
+
+// naive reference: diff every element against a snapshot taken at the last take_changes()
+bool matches(kt::tracked_flag_column<flags_t>& column, std::vector<flags_t>& baseline) {
+	std::vector<std::size_t> expected;
+	for (std::size_t i = 0; i < column.size(); ++i) {
+		if (column[i] != baseline[i]) { expected.push_back(i); }
+	}
+	KT_CHECK(expected.empty() || column.has_changes());
+	std::vector<std::size_t> reported;
+	bool ok = true;
+	column.take_changes([&](std::size_t index, kt::flag_changes<flags_t> const& changes) {
+		reported.push_back(index);
+		auto const diff = column[index] ^ baseline[index];
+		ok = ok && changes.rising == (diff & column[index]) && changes.falling == (diff & baseline[index]);
+	});
+	KT_CHECK(ok && reported == expected && !column.has_changes());
+	for (std::size_t i = 0; i < column.size(); ++i) { baseline[i] = column[i]; }
+	return true;
+}
+
+bool check_column() {
+	kt::tracked_flag_column<flags_t> column;
+	column.resize(5000);
+	std::vector<flags_t> baseline(column.size());
+	KT_CHECK(!column.has_changes() && matches(column, baseline));
+	std::uint32_t state = 0x2545'f491u;
+	for (int round = 0; round < 8; ++round) {
+		for (int i = 0; i < 300; ++i) {
+			state = state * 1664525u + 1013904223u;
+			auto const index = (state >> 8) % column.size();
+			auto const bit = static_cast<linear_e>(state >> 29);
+			if ((state & 1) != 0) {
+				column.set(index, bit);
+			} else {
+				column.reset(index, bit);
+			}
+		}
+		KT_CHECK(matches(column, baseline));
+	}
+	// changes that cancel out are skipped
+	column.set(4097, linear_e::g);
+	column.reset(4097, linear_e::g);
+	column.assign(64, column[64] ^ flags_t(linear_e::a));
+	KT_CHECK(column.has_changes() && matches(column, baseline));
+	// shrinking drops pending changes past the new size; growing adds clean elements
+	column.assign(4999, column[4999] ^ flags_t(linear_e::b));
+	column.assign(10, column[10] ^ flags_t(linear_e::b));
+	column.resize(4000);
+	baseline.resize(4000);
+	KT_CHECK(matches(column, baseline));
+	column.resize(4200);
+	baseline.resize(4200);
+	KT_CHECK(!column.has_changes() && column[4100] == flags_t{} && matches(column, baseline));
+	return true;
+}
+
+KT_CONSTEXPR_CHECK(check_tracked);
+} // namespace
+
+int main() {
+	kt::test::check_t const checks[] = {
+		KT_RUN_CHECK(check_tracked),
+		KT_RUN_CHECK(check_column),
+	};
+	return kt::test::run_checks(checks);
+}
@@ -0,0 +1,210 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "bit_utils.hpp"
+
+namespace kt {
+///
+/// \brief Bits that changed since the last take_changes()
+///
+template <typename Flags>
+struct flag_changes {
+	///
+	/// \brief Bits that are now set and were not
+	///
+	Flags rising{};
+	///
+	/// \brief Bits that are now unset and were set
+	///
+	Flags falling{};
+
+	constexpr bool any() const noexcept { return rising.any() || falling.any(); }
+};
+
+///
+/// \brief Flags that record which bits changed as modifications happen
+/// Changes accumulate by XOR, so a bit toggled back to its previous value is not reported
+///
+template <typename Flags>
+class tracked_flags {
+  public:
+	using flags_t = Flags;
+
+	constexpr tracked_flags() = default;
+	///
+	/// \brief Initialize with flags (no changes pending)
+	///
+	constexpr explicit tracked_flags(Flags flags) noexcept : m_value(flags) {}
+
+	constexpr Flags const& get() const noexcept { return m_value; }
+	constexpr operator Flags const&() const noexcept { return m_value; }
+
+	///
+	/// \brief Replace flags
+	///
+	constexpr tracked_flags& assign(Flags flags) noexcept;
+	///
+	/// \brief Set inputs
+	///
+	template <typename... T>
+	constexpr tracked_flags& set(T... t) noexcept {
+		return assign(Flags(m_value).set(t...));
+	}
+	///
+	/// \brief Remove inputs
+	///
+	template <typename... T>
+	constexpr tracked_flags& reset(T... t) noexcept {
+		return assign(Flags(m_value).reset(t...));
+	}
+	///
+	/// \brief Add set bits and remove unset bits
+	///
+	constexpr tracked_flags& update(Flags set, Flags unset = {}) noexcept { return assign(Flags(m_value).update(set, unset)); }
+
+	///
+	/// \brief Test if any bits changed since the last take_changes()
+	///
+	constexpr bool has_changes() const noexcept { return m_changed.any(); }
+	///
+	/// \brief Obtain bits that changed since the last take_changes()
+	///
+	constexpr Flags changed() const noexcept { return m_changed; }
+	///
+	/// \brief Obtain rising / falling bits and clear pending changes
+	///
+	constexpr flag_changes<Flags> take_changes() noexcept;
+
+  private:
+	Flags m_value{};
+	Flags m_changed{};
+};
+
+///
+/// \brief Column of tracked flags with a two level dirty index: one bit per element, one summary bit per 64 elements
+/// Scanning for changes touches only summary words, then dirty words whose summary bit is set, then dirty elements
+///
+template <typename Flags>
+class tracked_flag_column {
+  public:
+	using flags_t = Flags;
+
+	static constexpr std::size_t word_bits_v = 64;
+
+	std::size_t size() const noexcept { return m_values.size(); }
+	///
+	/// \brief Resize to count elements (new elements are unset and clean)
+	///
+	void resize(std::size_t count);
+	Flags const& operator[](std::size_t index) const noexcept { return m_values[index]; }
+
+	///
+	/// \brief Replace flags of element at index
+	///
+	void assign(std::size_t index, Flags flags) noexcept;
+	///
+	/// \brief Set inputs on element at index
+	///
+	template <typename... T>
+	void set(std::size_t index, T... t) noexcept {
+		assign(index, Flags(m_values[index]).set(t...));
+	}
+	///
+	/// \brief Remove inputs from element at index
+	///
+	template <typename... T>
+	void reset(std::size_t index, T... t) noexcept {
+		assign(index, Flags(m_values[index]).reset(t...));
+	}
+
+	///
+	/// \brief Test if any element is dirty
+	///
+	bool has_changes() const noexcept;
+	///
+	/// \brief Invoke func(std::size_t index, flag_changes<Flags> const&) for each dirty element (ascending) and clear all changes
+	/// Elements whose changes cancelled out are skipped
+	///
+	template <typename F>
+	void take_changes(F&& func);
+
+  private:
+	void mark(std::size_t index) noexcept;
+
+	std::vector<Flags> m_values;
+	std::vector<Flags> m_changed;
+	std::vector<std::uint64_t> m_dirty;
+	std::vector<std::uint64_t> m_summary;
+};
+
+// impl
+
+template <typename Flags>
+constexpr tracked_flags<Flags>& tracked_flags<Flags>::assign(Flags flags) noexcept {
+	m_changed ^= m_value ^ flags;
+	m_value = flags;
+	return *this;
+}
+template <typename Flags>
+constexpr flag_changes<Flags> tracked_flags<Flags>::take_changes() noexcept {
+	auto const rising = m_changed & m_value;
+	flag_changes<Flags> const ret{rising, m_changed ^ rising};
+	m_changed = {};
+	return ret;
+}
+
+template <typename Flags>
+void tracked_flag_column<Flags>::resize(std::size_t count) {
+	auto const words = (count + word_bits_v - 1) / word_bits_v;
+	m_values.resize(count);
+	m_changed.resize(count);
+	m_dirty.resize(words);
+	m_summary.resize((words + word_bits_v - 1) / word_bits_v);
+	if (count % word_bits_v != 0) { m_dirty.back() &= (std::uint64_t{1} << (count % word_bits_v)) - 1; }
+	if (words % word_bits_v != 0) { m_summary.back() &= (std::uint64_t{1} << (words % word_bits_v)) - 1; }
+}
+template <typename Flags>
+void tracked_flag_column<Flags>::mark(std::size_t index) noexcept {
+	auto const word = index / word_bits_v;
+	m_dirty[word] |= std::uint64_t{1} << (index % word_bits_v);
+	m_summary[word / word_bits_v] |= std::uint64_t{1} << (word % word_bits_v);
+}
+template <typename Flags>
+void tracked_flag_column<Flags>::assign(std::size_t index, Flags flags) noexcept {
+	auto& value = m_values[index];
+	if (value == flags) { return; }
+	m_changed[index] ^= value ^ flags;
+	value = flags;
+	mark(index);
+}
+template <typename Flags>
+bool tracked_flag_column<Flags>::has_changes() const noexcept {
+	for (auto const word : m_summary) {
+		if (word != 0) { return true; }
+	}
+	return false;
+}
+template <typename Flags>
+template <typename F>
+void tracked_flag_column<Flags>::take_changes(F&& func) {
+	for (std::size_t s = 0; s < m_summary.size(); ++s) {
+		detail::for_each_bit(m_summary[s], [&](std::size_t bit) {
+			auto const word = s * word_bits_v + bit;
+			detail::for_each_bit(m_dirty[word], [&](std::size_t offset) {
+				auto const index = word * word_bits_v + offset;
+				auto& changed = m_changed[index];
+				if (!changed.any()) { return; }
+				auto const rising = changed & m_values[index];
+				flag_changes<Flags> const changes{rising, changed ^ rising};
+				changed = {};
+				func(index, changes);
+			});
+			m_dirty[word] = 0;
+		});
+		m_summary[s] = 0;
+	}
+}
+} // namespace kt
@@ -11,9 +11,13 @@ namespace kt {
 template <typename Ty = std::uint32_t>
 struct uint_flags : detail::t_enum_flags_<uint_flags<Ty>, Ty> {
 	static_assert(std::is_unsigned_v<Ty>, "Ty must be unsigned");
+#if defined(KT_FLAGS_CONCEPTS)
+	static_assert(flag_storage<Ty>);
+#endif
 
 	using type = Ty;
 	using value_type = Ty;
+	using bit_type = Ty;
 
 	///
 	/// \brief Trivial storage (default initialized)
@@ -36,6 +40,12 @@ struct uint_flags : detail::t_enum_flags_<uint_flags<Ty>, Ty> {
 	/// \brief Add set bits and remove unset bits
 	///
 	template <typename T, typename U = T>
+#if defined(KT_FLAGS_CONCEPTS)
+		requires requires(T t, U u) {
+			static_cast<Ty>(t);
+			static_cast<Ty>(u);
+		}
+#endif
 	constexpr uint_flags<Ty>& update(T set, U unset = {}) noexcept {
 		bits |= static_cast<Ty>(set);
 		bits &= ~static_cast<Ty>(unset);
@@ -44,8 +54,10 @@ struct uint_flags : detail::t_enum_flags_<uint_flags<Ty>, Ty> {
 
   private:
 	constexpr Ty& get_ty() noexcept { return bits; }
+	static constexpr Ty to_bit(std::size_t index) noexcept { return static_cast<Ty>(static_cast<Ty>(1) << index); }
 
 	template <typename T, typename U>
 	friend struct kt::detail::t_enum_flags_;
+	friend struct set_bit_iterator<uint_flags>;
 };
 } // namespace kt
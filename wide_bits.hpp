@@ -0,0 +1,135 @@
+// KT header-only library
+// Requirements: C++17
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "bit_utils.hpp"
+
+namespace kt {
+///
+/// \brief Multi-word bit storage for flags wider than 64 bits (usable as Ty in enum_flags)
+/// All operations are word-wise loops over a fixed size array
+///
+template <std::size_t N>
+struct wide_bits {
+	static_assert(N > 0, "N must be positive");
+
+	using word_t = std::uint64_t;
+	static constexpr std::size_t word_bits_v = sizeof(word_t) * 8;
+	static constexpr std::size_t size_v = N * word_bits_v;
+
+	std::array<word_t, N> words{};
+
+	///
+	/// \brief Set bit at index
+	///
+	constexpr wide_bits& set_bit(std::size_t index) noexcept;
+	///
+	/// \brief Test bit at index
+	///
+	constexpr bool test_bit(std::size_t index) const noexcept;
+	///
+	/// \brief Obtain number of set bits
+	///
+	constexpr std::size_t count() const noexcept;
+	///
+	/// \brief Obtain index of lowest set bit (size_v if none are set)
+	///
+	constexpr std::size_t countr_zero() const noexcept;
+	///
+	/// \brief Obtain a copy with the lowest set bit cleared
+	///
+	constexpr wide_bits clear_lowest() const noexcept;
+
+	constexpr wide_bits& operator|=(wide_bits const& rhs) noexcept;
+	constexpr wide_bits& operator&=(wide_bits const& rhs) noexcept;
+	constexpr wide_bits& operator^=(wide_bits const& rhs) noexcept;
+	constexpr wide_bits operator~() const noexcept;
+
+	friend constexpr wide_bits operator|(wide_bits lhs, wide_bits const& rhs) noexcept { return lhs |= rhs; }
+	friend constexpr wide_bits operator&(wide_bits lhs, wide_bits const& rhs) noexcept { return lhs &= rhs; }
+	friend constexpr wide_bits operator^(wide_bits lhs, wide_bits const& rhs) noexcept { return lhs ^= rhs; }
+	friend constexpr bool operator==(wide_bits const& lhs, wide_bits const& rhs) noexcept {
+		for (std::size_t i = 0; i < N; ++i) {
+			if (lhs.words[i] != rhs.words[i]) { return false; }
+		}
+		return true;
+	}
+	friend constexpr bool operator!=(wide_bits const& lhs, wide_bits const& rhs) noexcept { return !(lhs == rhs); }
+};
+
+///
+/// \brief Obtain the number of 64-bit words required to store a number of bits
+///
+constexpr std::size_t wide_words(std::size_t bits) noexcept { return bits == 0 ? 1 : (bits + 63) / 64; }
+
+namespace detail {
+template <typename T>
+struct is_wide_bits : std::false_type {};
+template <std::size_t N>
+struct is_wide_bits<wide_bits<N>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_wide_bits_v = is_wide_bits<T>::value;
+} // namespace detail
+
+// impl
+
+template <std::size_t N>
+constexpr wide_bits<N>& wide_bits<N>::set_bit(std::size_t index) noexcept {
+	words[index / word_bits_v] |= word_t{1} << (index % word_bits_v);
+	return *this;
+}
+template <std::size_t N>
+constexpr bool wide_bits<N>::test_bit(std::size_t index) const noexcept {
+	return (words[index / word_bits_v] & (word_t{1} << (index % word_bits_v))) != 0;
+}
+template <std::size_t N>
+constexpr std::size_t wide_bits<N>::count() const noexcept {
+	std::size_t ret{};
+	for (std::size_t i = 0; i < N; ++i) { ret += detail::popcount(words[i]); }
+	return ret;
+}
+template <std::size_t N>
+constexpr std::size_t wide_bits<N>::countr_zero() const noexcept {
+	for (std::size_t i = 0; i < N; ++i) {
+		if (words[i] != 0) { return i * word_bits_v + detail::countr_zero(words[i]); }
+	}
+	return size_v;
+}
+template <std::size_t N>
+constexpr wide_bits<N> wide_bits<N>::clear_lowest() const noexcept {
+	auto ret = *this;
+	for (std::size_t i = 0; i < N; ++i) {
+		if (ret.words[i] != 0) {
+			ret.words[i] = detail::clear_lowest(ret.words[i]);
+			break;
+		}
+	}
+	return ret;
+}
+template <std::size_t N>
+constexpr wide_bits<N>& wide_bits<N>::operator|=(wide_bits const& rhs) noexcept {
+	for (std::size_t i = 0; i < N; ++i) { words[i] |= rhs.words[i]; }
+	return *this;
+}
+template <std::size_t N>
+constexpr wide_bits<N>& wide_bits<N>::operator&=(wide_bits const& rhs) noexcept {
+	for (std::size_t i = 0; i < N; ++i) { words[i] &= rhs.words[i]; }
+	return *this;
+}
+template <std::size_t N>
+constexpr wide_bits<N>& wide_bits<N>::operator^=(wide_bits const& rhs) noexcept {
+	for (std::size_t i = 0; i < N; ++i) { words[i] ^= rhs.words[i]; }
+	return *this;
+}
+template <std::size_t N>
+constexpr wide_bits<N> wide_bits<N>::operator~() const noexcept {
+	wide_bits ret;
+	for (std::size_t i = 0; i < N; ++i) { ret.words[i] = ~words[i]; }
+	return ret;
+}
+} // namespace kt